@@ -0,0 +1,69 @@
+// 𝔽⎊𝔾 in a tight loop as input validation has it, by the entry point chosen for 𝔽 and by the setjmp handler of the
+// evokation. 𝕩 is 1, which ! passes, then 5, which it throws on
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <time.h>
+
+#include "local.h"
+
+static double now(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// as op 27 of the VM applies a primitive modifier
+static fern_Box m2(fern_Box f, fern_Box m, fern_Box g) {
+  fern_Modifier2 modifier = fern_unpack_modifier2(m);
+  fern_Function result = fern_allocate_function();
+  result->type = fern_FunctionType_applied_c_m2;
+  result->applied_c_m2.f = f;
+  result->applied_c_m2.m = modifier->c;
+  result->applied_c_m2.g = g;
+  result->applied_c_m2.monad = modifier->monad;
+  result->applied_c_m2.dyad = modifier->dyad;
+  fern_internal_recognize_idiom(result);
+  fern_internal_compile_function(result);
+  return fern_pack_function(result);
+}
+
+static fern_Box train3(fern_Box f, fern_Box g, fern_Box h) {
+  fern_Function result = fern_allocate_function();
+  result->type = fern_FunctionType_train3;
+  result->train3.f = f;
+  result->train3.g = g;
+  result->train3.h = h;
+  fern_internal_compile_function(result);
+  return fern_pack_function(result);
+}
+
+static void calls(const char * name, fern_Box f, uint32_t n) {
+  fern_Function function = fern_unpack_function(f);
+  for(uint32_t pass = 0; pass < 2; pass++) {
+    fern_Box x = fern_pack_number(pass ? 5 : 1);
+    double entry_sum = 0, evokation_sum = 0;
+    double start = now();
+    for(uint32_t i = 0; i < n; i++) {
+      entry_sum += CALL_1(f, x).number;
+    }
+    double entry = now() - start;
+    start = now();
+    for(uint32_t i = 0; i < n; i++) {
+      evokation_sum += function->applied_c_m2.m(fern_Evokation_monad, function->applied_c_m2.f, function->applied_c_m2.g, x, fern_nil()).number;
+    }
+    double evokation = now() - start;
+    if(entry_sum != evokation_sum) {
+      fern_fatal_error("catch: results differ");
+    }
+    printf("%s %g: entry %6.2f ns/call, setjmp %6.2f ns/call\n", name, x.number, entry / n * 1e9, evokation / n * 1e9);
+  }
+}
+
+int main(void) {
+  uint32_t n = 30000000;
+  fern_Box catch = fern_CIRCLED_TRIANGLE_DOWN();
+  calls("+⎊0", m2(fern_PLUS_SIGN(), catch, fern_DIGIT_ZERO()), n);
+  calls("!⎊¯1", m2(fern_EXCLAMATION_MARK(), catch, fern_pack_number(-1)), n);
+  calls("(⊢!⊢)⎊¯2", m2(train3(fern_RIGHT_TACK(), fern_EXCLAMATION_MARK(), fern_RIGHT_TACK()), catch, fern_pack_number(-2)), n);
+  return 0;
+}
@@ -0,0 +1,62 @@
+// the cost of dispatching an op of the VM, over a long body of cheap ops: variable get and ref, const, quick dyad, set,
+// drop and nothing. build it with and without FERN_BQN_SWITCH to compare the threaded interpreter with the switch
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <time.h>
+
+#include "bqn.c"
+
+#define STATEMENTS 500
+#define OPS_PER_STATEMENT 13
+
+static double now(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main(void) {
+  fern_Box consts[] = { fern_PLUS_SIGN(), fern_DIGIT_ONE(), fern_DIGIT_ZERO(), fern_HYPHEN_MINUS() };
+  static uint32_t bc[STATEMENTS * 22 + 4];
+  uint32_t length = 0;
+  // a ← a + 1 or a ← a - 1 by turns, then 0, a and · dropped
+  for(uint32_t i = 0; i < STATEMENTS; i++) {
+    uint32_t statement[] = {
+      33, 0, 0,  32, 0, 0,  0, i & 1 ? 3 : 0,  0, 1,  17,  48,  6,  0, 2,  6,  32, 0, 0,  6,  44,  6
+    };
+    memcpy(bc + length, statement, sizeof(statement));
+    length += sizeof(statement) / sizeof(*statement);
+  }
+  uint32_t end[] = { 32, 0, 0,  7 };
+  memcpy(bc + length, end, sizeof(end));
+  length += sizeof(end) / sizeof(*end);
+
+  struct Body bodies[] = { { 0, 1, 0, NULL } };
+  struct Program program = {
+      .bc = bc, .num_bc = length, .num_consts = sizeof(consts) / sizeof(*consts), .consts = consts, .num_bodies = 1
+    , .bodies = bodies
+  };
+  Program_prepare(&program);
+  struct Env * env = Env_allocate(1);
+  env->type = ObjectType_env;
+  env->parent = NULL;
+  env->program = &program;
+  env->num_vars = 1;
+  env->first_named_var = 1;
+  Var_init(env->vars, &program, 0);
+  Var_set_n(env->vars, fern_DIGIT_ZERO());
+
+  // the first run quickens the dyads
+  run_bc(bc, 0, env);
+  uint32_t runs = 20000;
+  double start = now();
+  for(uint32_t i = 0; i < runs; i++) {
+    run_bc(bc, 0, env);
+  }
+  double time = now() - start;
+  if(!fern_is_number(env->vars[0].value) || env->vars[0].value.number != 0) {
+    fern_fatal_error("dispatch: wrong result");
+  }
+  printf("%s %.2f ns/op\n", BQN_THREADED ? "threaded" : "switch", time / ((double)runs * STATEMENTS * OPS_PER_STATEMENT) * 1e9);
+  return 0;
+}
@@ -0,0 +1,40 @@
+// the cost of a call through fern_evoke, by the direct dyad entry point and by the evokation it falls back to without one
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <time.h>
+
+#include "local.h"
+
+static double now(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// ns per call of n rounds of three dyadic calls of f, each round adding 1
+static double calls(fern_Box f, uint32_t n) {
+  fern_Box acc = fern_pack_number(0);
+  double start = now();
+  for(uint32_t i = 0; i < n; i++) {
+    acc = fern_evoke(f, fern_Evokation_dyad, acc, fern_pack_number(1));
+    acc = fern_evoke(f, fern_Evokation_dyad, acc, fern_pack_number(-1));
+    acc = fern_evoke(f, fern_Evokation_dyad, acc, fern_pack_number(1));
+  }
+  double time = now() - start;
+  if(acc.number != n) {
+    fern_fatal_error("evoke: wrong sum");
+  }
+  return time / (3.0 * n) * 1e9;
+}
+
+int main(void) {
+  uint32_t n = 30000000;
+  fern_Function plus = fern_unpack_function(fern_PLUS_SIGN());
+  fern_FunctionDyad dyad = plus->dyad;
+  double direct = calls(fern_PLUS_SIGN(), n);
+  plus->dyad = NULL;
+  double evokation = calls(fern_PLUS_SIGN(), n);
+  plus->dyad = dyad;
+  printf("+ direct %.2f ns/call, evokation %.2f ns/call\n", direct, evokation);
+  return 0;
+}
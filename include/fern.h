@@ -27,7 +27,7 @@ typedef union {
 
 #define FERN_BOX_NAN_MASK     0xfff8000000000000ull
 #define FERN_BOX_NAN_QUIET    0x7ff8000000000000ull
-#define FERN_BOX_PAYLOAD_MASK 0x000fffffffffffffull
+#define FERN_BOX_PAYLOAD_MASK 0x0000ffffffffffffull
 #define FERN_BOX_INVALID      (1 << 3)
 
 #define FERN_CONSTRUCT_BOX(TAG, PAYLOAD) ((fern_Box) { .bits = FERN_BOX_NAN_QUIET | ((uint64_t)(TAG) << 48) | (PAYLOAD) })
@@ -106,6 +106,43 @@ typedef fern_Box (*fern_FunctionEvokation)(fern_Evokation evokation, fern_Box x,
 typedef fern_Box (*fern_Modifier1Evokation)(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w);
 typedef fern_Box (*fern_Modifier2Evokation)(fern_Evokation evokation, fern_Box f, fern_Box g, fern_Box x, fern_Box w);
 
+// direct entry points for the monad and the dyad, skipping the switch over fern_Evokation on the hot paths. the inverse and
+// the emit take 𝕩 and 𝕨 as the dyad does, 𝕨 nothing for an inverse of the monad. all are optional, NULL goes through the
+// evokation
+typedef fern_Box (*fern_FunctionMonad)(fern_Box x);
+typedef fern_Box (*fern_FunctionDyad)(fern_Box x, fern_Box w);
+typedef fern_Box (*fern_Modifier1Monad)(fern_Box f, fern_Box x);
+typedef fern_Box (*fern_Modifier1Dyad)(fern_Box f, fern_Box x, fern_Box w);
+typedef fern_Box (*fern_Modifier2Monad)(fern_Box f, fern_Box g, fern_Box x);
+typedef fern_Box (*fern_Modifier2Dyad)(fern_Box f, fern_Box g, fern_Box x, fern_Box w);
+
+// a derived function flattened into straight line calls, one list for the monad and one for the dyad. registers 0 and 1
+// hold 𝕩 and 𝕨, step i writes register 2 + i and the constant operands follow the steps. the constants and steps are
+// allocated with the closure, sized to what it holds, of at most fern_CLOSURE_MAX each
+#define fern_CLOSURE_MAX 32
+#define fern_CLOSURE_NONE UINT8_MAX
+
+typedef struct fern_ClosureStep {
+  union {
+    fern_FunctionMonad monad;
+    fern_FunctionDyad dyad;
+  };                        // the direct entry point by the arity of the step, NULL uses `c`
+  fern_FunctionEvokation c; // NULL evokes `callee` through fern_evoke
+  fern_Box callee;
+  uint8_t x;
+  uint8_t w;                // fern_CLOSURE_NONE for a monadic call
+} fern_ClosureStep;
+
+typedef struct fern_Closure {
+  uint32_t num_consts;
+  fern_Box * consts;
+  struct {
+    uint32_t num_steps;
+    fern_ClosureStep * steps;
+    uint8_t result;
+  } code[2]; // by fern_Evokation_monad and fern_Evokation_dyad
+} *fern_Closure;
+
 // these will be expanded later
 enum fern_FunctionType {
     fern_FunctionType_c
@@ -121,7 +158,17 @@ enum fern_FunctionType {
 typedef struct fern_Function {
   enum fern_FunctionType type;
   union {
-    fern_FunctionEvokation c;
+    struct {
+      fern_FunctionEvokation c;
+      fern_FunctionMonad monad;
+      fern_FunctionDyad dyad;
+      fern_FunctionDyad inverse;
+      fern_FunctionDyad emit;
+    };
+    struct {
+      void * env;     // the struct Env the block was defined in, see bqn.c
+      uint32_t index; // into the blocks of the program of env
+    } block;
     struct {
       fern_Box f;
       fern_Box m;
@@ -129,6 +176,10 @@ typedef struct fern_Function {
     struct {
       fern_Box f;
       fern_Modifier1Evokation m;
+      fern_Modifier1Monad monad;
+      fern_Modifier1Dyad dyad;
+      fern_Modifier1Dyad inverse;
+      fern_Modifier1Dyad emit;
     } applied_c_m1;
     struct {
       fern_Box f;
@@ -139,6 +190,10 @@ typedef struct fern_Function {
       fern_Box f;
       fern_Modifier2Evokation m;
       fern_Box g;
+      fern_Modifier2Monad monad;
+      fern_Modifier2Dyad dyad;
+      fern_Modifier2Dyad inverse;
+      fern_Modifier2Dyad emit;
     } applied_c_m2;
     struct {
       fern_Box g;
@@ -150,6 +205,7 @@ typedef struct fern_Function {
       fern_Box h;
     } train3;
   };
+  fern_Closure closure; // flattened form of a derived function, NULL when evoked by type
 } *fern_Function;
 
 enum fern_Modifier1Type {
@@ -162,7 +218,17 @@ enum fern_Modifier1Type {
 typedef struct fern_Modifier1 {
   enum fern_Modifier1Type type;
   union {
-    fern_Modifier1Evokation c;
+    struct {
+      fern_Modifier1Evokation c;
+      fern_Modifier1Monad monad;
+      fern_Modifier1Dyad dyad;
+      fern_Modifier1Dyad inverse;
+      fern_Modifier1Dyad emit;
+    };
+    struct {
+      void * env;     // the struct Env the block was defined in, see bqn.c
+      uint32_t index; // into the blocks of the program of env
+    } block;
     struct {
       fern_Box m;
       fern_Box g;
@@ -182,7 +248,17 @@ enum fern_Modifier2Type {
 typedef struct fern_Modifier2 {
   enum fern_Modifier2Type type;
   union {
-    fern_Modifier2Evokation c;
+    struct {
+      fern_Modifier2Evokation c;
+      fern_Modifier2Monad monad;
+      fern_Modifier2Dyad dyad;
+      fern_Modifier2Dyad inverse;
+      fern_Modifier2Dyad emit;
+    };
+    struct {
+      void * env;     // the struct Env the block was defined in, see bqn.c
+      uint32_t index; // into the blocks of the program of env
+    } block;
   };
 } *fern_Modifier2;
 
@@ -315,6 +391,7 @@ static inline fern_Box fern_pack_number(double number) {
 // object lifetime
 void * fern_init_data(fern_Data data, fern_Format format, uint32_t size);
 void fern_clone_data(fern_Data data, fern_Data other);
+void fern_slice_data(fern_Data data, fern_Data other, uint32_t start, uint32_t size);
 void fern_free_data(fern_Data data);
 
 fern_Array fern_allocate_array(void);
@@ -429,7 +506,7 @@ static inline fern_Box fern_data_get_cell(fern_DataReader reader, uintptr_t inde
 
 static inline int64_t fern_force_natural(fern_Box b) {
   if(fern_is_number(b)) {
-    if(round(b.number) == b.number && b.number < (1ull << 32)) {
+    if(round(b.number) == b.number && b.number >= 0 && b.number < (1ull << 32)) {
       return (uint32_t)b.number;
     } else {
       return -1;
@@ -473,6 +550,11 @@ static inline uint32_t fern_array_num_cells(fern_ArrayReader reader) {
   return result;
 }
 
+// whether every cell is stored, rather than cells at the end reading as the fill
+static inline bool fern_array_complete(fern_ArrayReader reader) {
+  return reader.cells.size >= fern_array_num_cells(reader);
+}
+
 static inline fern_Box fern_array_get_cell(fern_ArrayReader reader, uint32_t index) {
   if(index >= reader.cells.size) {
     return reader.fill;
@@ -580,23 +662,66 @@ void fern_namespace_redefine(fern_Namespace namespace, uint32_t symbol, fern_Box
 //   •Time •Show // assuming Time ignores 𝕩
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
+fern_Box fern_evoke_closure(fern_Closure closure, fern_Evokation evokation, fern_Box x, fern_Box w);
+
+// block functions and functions derived from block modifiers, run by the vm in bqn.c
+fern_Box fern_evoke_block(fern_Box evokable, fern_Evokation evokation, fern_Box x, fern_Box w);
+
 static inline fern_Box fern_evoke(fern_Box evokable, fern_Evokation evokation, fern_Box x, fern_Box w) {
   switch(fern_tag(evokable)) {
   case fern_Tag_function:
     {
       fern_Function function = fern_unpack_function(evokable);
+      if(function->closure && evokation <= fern_Evokation_dyad) {
+        return fern_evoke_closure(function->closure, evokation, x, w);
+      }
       switch(function->type) {
       case fern_FunctionType_c:
+        if(evokation == fern_Evokation_monad && function->monad) {
+          return function->monad(x);
+        }
+        if(evokation == fern_Evokation_dyad && function->dyad) {
+          return function->dyad(x, w);
+        }
+        if(evokation == fern_Evokation_inverse && function->inverse) {
+          return function->inverse(x, w);
+        }
+        if(evokation == fern_Evokation_write_to_backend && function->emit) {
+          return function->emit(x, w);
+        }
         return function->c(evokation, x, w);
       case fern_FunctionType_block:
-        fern_fatal_error("not implemented");
       case fern_FunctionType_applied_m1:
-        fern_fatal_error("not implemented");
+        return fern_evoke_block(evokable, evokation, x, w);
       case fern_FunctionType_applied_c_m1:
+        if(evokation == fern_Evokation_monad && function->applied_c_m1.monad) {
+          return function->applied_c_m1.monad(function->applied_c_m1.f, x);
+        }
+        if(evokation == fern_Evokation_dyad && function->applied_c_m1.dyad) {
+          return function->applied_c_m1.dyad(function->applied_c_m1.f, x, w);
+        }
+        if(evokation == fern_Evokation_inverse && function->applied_c_m1.inverse) {
+          return function->applied_c_m1.inverse(function->applied_c_m1.f, x, w);
+        }
+        if(evokation == fern_Evokation_write_to_backend && function->applied_c_m1.emit) {
+          return function->applied_c_m1.emit(function->applied_c_m1.f, x, w);
+        }
         return function->applied_c_m1.m(evokation, function->applied_c_m1.f, x, w);
       case fern_FunctionType_applied_m2:
-        fern_fatal_error("not implemented");
+        return fern_evoke_block(evokable, evokation, x, w);
       case fern_FunctionType_applied_c_m2:
+        if(evokation == fern_Evokation_monad && function->applied_c_m2.monad) {
+          return function->applied_c_m2.monad(function->applied_c_m2.f, function->applied_c_m2.g, x);
+        }
+        if(evokation == fern_Evokation_dyad && function->applied_c_m2.dyad) {
+          return function->applied_c_m2.dyad(function->applied_c_m2.f, function->applied_c_m2.g, x, w);
+        }
+        if(evokation == fern_Evokation_inverse && function->applied_c_m2.inverse) {
+          return function->applied_c_m2.inverse(function->applied_c_m2.f, function->applied_c_m2.g, x, w);
+        }
+        if(evokation == fern_Evokation_write_to_backend && function->applied_c_m2.emit) {
+          return function->applied_c_m2.emit(function->applied_c_m2.f, function->applied_c_m2.g, x, w);
+        }
         return function->applied_c_m2.m(evokation, function->applied_c_m2.f, function->applied_c_m2.g, x, w);
       case fern_FunctionType_train2:
         return fern_evoke(
@@ -1,14 +1,49 @@
 #include "local.h"
 
+// the interpreter is direct threaded through computed goto where the compiler has labels as values. FERN_BQN_SWITCH builds
+// the portable switch instead
+#if defined(__GNUC__) && !defined(FERN_BQN_SWITCH)
+#define BQN_THREADED 1
+#else
+#define BQN_THREADED 0
+#endif
+
+struct Block {
+  uint32_t type; // 0 function, 1 1-modifier, 2 2-modifier
+  bool immediate;
+  uint32_t num_bodies;
+  uint32_t * bodies; // one body for every evokation, or the monad bodies then as many dyad bodies. (uint32_t)-1 pads
+};
+
+struct Body {
+  uint32_t start;
+  uint32_t num_vars;
+  uint32_t num_names;
+  uint32_t * names; // symbols of the named variables, the last num_names of the body
+  uint32_t max_stack; // deepest the value stack gets in the body, see Program_prepare
+};
+
 struct Program {
+  uint32_t * bc;
+  const void ** threaded; // handler of the op at each position of bc when BQN_THREADED, see Program_prepare
+
   uint32_t num_consts;
   fern_Box * consts;
 
   uint32_t num_blocks;
-  uint32_t * blocks;
+  struct Block * blocks;
+
+  uint32_t num_bodies;
+  struct Body * bodies;
 
   uint32_t num_names;
   uint32_t * names;
+
+  // inline caches of the applications, found by the position of their op in the bytecode
+  uint32_t num_bc;
+  uint32_t * call_sites; // 1 + index into call_caches per position, 0 until the application there first runs
+  uint32_t num_call_caches;
+  struct CallCache * call_caches;
 };
 
 enum ObjectType {
@@ -71,6 +106,7 @@ struct Var {
   struct Program * program;
   uint32_t name;
   fern_Box value;
+  bool owned; // value came from a structural ⌾ in a modified assignment and has not been read since
 };
 
 static void Var_init(struct Var * var, struct Program * program, uint32_t name);
@@ -100,6 +136,7 @@ struct Env {
 };
 
 struct Env * Env_allocate(uint32_t num_vars);
+void Env_free(struct Env * env);
 void Env_init(struct Env * env, struct Env * p, uint32_t v, uint32_t * n, uint32_t num_n);
 void Env_tini(struct Env * env);
 
@@ -206,7 +243,11 @@ static inline void Object_free(union Object * object) {
   
   if(m_dec(object)) {
     Object_tini(object);
-    m_free(object);
+    if(object->type == ObjectType_env) {
+      Env_free(&object->env);
+    } else {
+      m_free(object);
+    }
   }
 }
 
@@ -295,6 +336,7 @@ void Var_init(struct Var * var, struct Program * program, uint32_t name) {
   var->program = program;
   var->name = name;
   var->value = fern_COMMERCIAL_AT();
+  var->owned = false;
 }
 
 void Var_tini(struct Var * var) {
@@ -305,6 +347,11 @@ fern_Box Var_get(struct Var * var, fern_Box x) {
   (void)x;
   fern_assert_fatal_error(var->type != ObjectType_var_unset, u8"Runtime: Variable referenced before definition");
   fern_assert_fatal_error(var->type != ObjectType_var_cleared, u8"Internal error: Variable used after clear");
+  // another reference to the value now exists
+  var->owned = false;
+  if(var->value.bits == fern_internal_owned.bits) {
+    fern_internal_owned = fern_nil();
+  }
   return var->value;
 }
 
@@ -312,6 +359,7 @@ fern_Box Var_set_n(struct Var * var, fern_Box x) {
   fern_assert_fatal_error(var->type != ObjectType_var_cleared, u8"Internal error: Variable used after clear");
   var->type = ObjectType_var_set;
   var->value = x;
+  var->owned = false;
   return x;
 }
 
@@ -319,6 +367,7 @@ fern_Box Var_set_u(struct Var * var, fern_Box x) {
   fern_assert_fatal_error(var->type != ObjectType_var_unset, u8"↩: Variable modified before definition");
   fern_assert_fatal_error(var->type != ObjectType_var_cleared, u8"Internal error: Variable used after clear");
   var->value = x;
+  var->owned = false;
   return x;
 }
 
@@ -338,21 +387,56 @@ struct Var * Var_get_f(struct Var * var, struct NS * x) {
 }
 
 // Env ----------------------------------------------------------------------------------------------------------------
+// frames come from a pool by size class, the number of variables rounded up to a power of two. a freed frame goes on the
+// free list of its class, linked through parent, so the next call into a block of that class takes it back. a tail call
+// frees its frame before it enters the callee, which runs in the same memory
+#define ENV_POOL_CLASSES 8 // up to 128 variables, larger frames are not pooled
+
+static struct Env * env_pool[ENV_POOL_CLASSES];
+
+static inline uint32_t Env_class(uint32_t num_vars) {
+  uint32_t c = 0;
+  while((1u << c) < num_vars) {
+    c++;
+  }
+  return c;
+}
+
 struct Env * Env_allocate(uint32_t num_vars) {
-  return (struct Env *)m_allocate(sizeof(struct Env) + sizeof(struct Var) * (num_vars - 1));
+  uint32_t c = Env_class(num_vars);
+  if(c >= ENV_POOL_CLASSES) {
+    return (struct Env *)m_allocate(sizeof(struct Env) + sizeof(struct Var) * (num_vars - 1));
+  }
+  struct Env * env = env_pool[c];
+  if(env == NULL) {
+    return (struct Env *)m_allocate(sizeof(struct Env) + sizeof(struct Var) * ((1u << c) - 1));
+  }
+  env_pool[c] = env->parent;
+  m_inc(env);
+  return env;
+}
+
+void Env_free(struct Env * env) {
+  uint32_t c = Env_class(env->num_vars);
+  if(c >= ENV_POOL_CLASSES) {
+    m_free(env);
+    return;
+  }
+  env->parent = env_pool[c];
+  env_pool[c] = env;
 }
 
 void Env_init(struct Env * env, struct Env * p, uint32_t v, uint32_t * n, uint32_t num_n) {
   env->type = ObjectType_env;
-  env->parent = p;
+  env->parent = (struct Env *)Object_clone((union Object *)p);
   env->program = p->program;
   env->num_vars = v;
   env->first_named_var = v - num_n;
-  for(uint32_t i = 0; i < v - num_n; i++) {
+  for(uint32_t i = 0; i < env->first_named_var; i++) {
     Var_init(env->vars + i, env->program, 0);
   }
   for(uint32_t i = env->first_named_var; i < v; i++) {
-    Var_init(env->vars + i, env->program, n[i - num_n]);
+    Var_init(env->vars + i, env->program, n[i - env->first_named_var]);
   }
 }
 
@@ -360,6 +444,9 @@ void Env_tini(struct Env * env) {
   for(uint32_t i = 0; i < env->num_vars; i++) {
     Var_tini(env->vars + i);
   }
+  if(env->parent != NULL) {
+    Object_free((union Object *)env->parent);
+  }
 }
 
 // NS -----------------------------------------------------------------------------------------------------------------
@@ -408,8 +495,9 @@ static void Matcher_tini(struct Matcher * matcher) {
   fern_free(matcher->value);
 }
 
+// as with the other set_q, 0 when x fits and the header is taken, 1 when op 47 rejects the body
 static fern_Box Matcher_set_q(struct Matcher * matcher, fern_Box x) {
-  return fern_internal_match(matcher->value, x) ? fern_DIGIT_ONE() : fern_DIGIT_ZERO();
+  return fern_internal_match(matcher->value, x) ? fern_DIGIT_ZERO() : fern_DIGIT_ONE();
 }
 
 // Array --------------------------------------------------------------------------------------------------------------
@@ -516,34 +604,241 @@ static struct Var * Alias_get_f(struct Alias * alias, struct NS * x) {
   return NS_field(x, alias->name, alias->env->program);
 }
 
+// CallCache ----------------------------------------------------------------------------------------------------------
+// each application keeps the last few callees it saw, resolved down to the C entry point with the operands of an applied
+// modifier already bound, or to the closure of a derived function. functions are never changed once built, so the bits of
+// the callee are the key. the evokation is part of the key too, the entry holding the direct entry point for its arity
+// when the callee has one
+#define CALL_CACHE_WAYS 4
+
+enum CallKind {
+    CallKind_evoke
+  , CallKind_value
+  , CallKind_c
+  , CallKind_c_m1
+  , CallKind_c_m2
+  , CallKind_closure
+  , CallKind_monad
+  , CallKind_dyad
+  , CallKind_m1_monad
+  , CallKind_m1_dyad
+  , CallKind_m2_monad
+  , CallKind_m2_dyad
+};
+
+struct CallEntry {
+  uint64_t key;
+  fern_Evokation evokation;
+  enum CallKind kind;
+  union {
+    fern_FunctionEvokation c;
+    fern_Modifier1Evokation m1;
+    fern_Modifier2Evokation m2;
+    fern_Closure closure;
+    fern_FunctionMonad monad;
+    fern_FunctionDyad dyad;
+    fern_Modifier1Monad m1_monad;
+    fern_Modifier1Dyad m1_dyad;
+    fern_Modifier2Monad m2_monad;
+    fern_Modifier2Dyad m2_dyad;
+  };
+  fern_Box f;
+  fern_Box g;
+};
+
+struct CallCache {
+  uint32_t length;
+  uint32_t next; // way replaced next once all are in use
+  struct CallEntry entries[CALL_CACHE_WAYS];
+};
+
+static struct CallCache * Program_call_cache(struct Program * program, uint32_t pos) {
+  if(program->call_sites == NULL) {
+    program->call_sites = calloc(program->num_bc, sizeof(uint32_t));
+  }
+  if(program->call_sites[pos] == 0) {
+    program->call_caches = realloc(program->call_caches, sizeof(struct CallCache) * (program->num_call_caches + 1));
+    program->call_caches[program->num_call_caches] = (struct CallCache){ 0 };
+    program->call_sites[pos] = ++program->num_call_caches;
+  }
+  return program->call_caches + program->call_sites[pos] - 1;
+}
+
+static struct CallEntry CallCache_resolve(fern_Box f, fern_Evokation evokation) {
+  struct CallEntry entry = { .key = f.bits, .evokation = evokation, .kind = CallKind_evoke };
+  if(!fern_is_function(f)) {
+    entry.kind = CallKind_value;
+    return entry;
+  }
+  fern_Function function = fern_unpack_function(f);
+  if(function->closure != NULL) {
+    entry.kind = CallKind_closure;
+    entry.closure = function->closure;
+    return entry;
+  }
+  bool monad = evokation == fern_Evokation_monad;
+  switch(function->type) {
+  case fern_FunctionType_c:
+    if(monad && function->monad) {
+      entry.kind = CallKind_monad;
+      entry.monad = function->monad;
+    } else if(!monad && function->dyad) {
+      entry.kind = CallKind_dyad;
+      entry.dyad = function->dyad;
+    } else {
+      entry.kind = CallKind_c;
+      entry.c = function->c;
+    }
+    break;
+  case fern_FunctionType_applied_c_m1:
+    entry.f = function->applied_c_m1.f;
+    if(monad && function->applied_c_m1.monad) {
+      entry.kind = CallKind_m1_monad;
+      entry.m1_monad = function->applied_c_m1.monad;
+    } else if(!monad && function->applied_c_m1.dyad) {
+      entry.kind = CallKind_m1_dyad;
+      entry.m1_dyad = function->applied_c_m1.dyad;
+    } else {
+      entry.kind = CallKind_c_m1;
+      entry.m1 = function->applied_c_m1.m;
+    }
+    break;
+  case fern_FunctionType_applied_c_m2:
+    entry.f = function->applied_c_m2.f;
+    entry.g = function->applied_c_m2.g;
+    if(monad && function->applied_c_m2.monad) {
+      entry.kind = CallKind_m2_monad;
+      entry.m2_monad = function->applied_c_m2.monad;
+    } else if(!monad && function->applied_c_m2.dyad) {
+      entry.kind = CallKind_m2_dyad;
+      entry.m2_dyad = function->applied_c_m2.dyad;
+    } else {
+      entry.kind = CallKind_c_m2;
+      entry.m2 = function->applied_c_m2.m;
+    }
+    break;
+  default:
+    break;
+  }
+  return entry;
+}
+
+// fern_evoke through the cache of one application. the entry is copied out since the callee may run bytecode that grows
+// the caches
+static inline fern_Box CallCache_evoke(struct CallCache * cache, fern_Box f, fern_Evokation evokation, fern_Box x, fern_Box w) {
+  struct CallEntry entry;
+  uint32_t i = 0;
+  while(i < cache->length && (cache->entries[i].key != f.bits || cache->entries[i].evokation != evokation)) {
+    i++;
+  }
+  if(i < cache->length) {
+    entry = cache->entries[i];
+  } else {
+    entry = CallCache_resolve(f, evokation);
+    uint32_t way = cache->length < CALL_CACHE_WAYS ? cache->length++ : cache->next++ % CALL_CACHE_WAYS;
+    cache->entries[way] = entry;
+  }
+  switch(entry.kind) {
+  case CallKind_value:
+    return f;
+  case CallKind_c:
+    return entry.c(evokation, x, w);
+  case CallKind_c_m1:
+    return entry.m1(evokation, entry.f, x, w);
+  case CallKind_c_m2:
+    return entry.m2(evokation, entry.f, entry.g, x, w);
+  case CallKind_closure:
+    return fern_evoke_closure(entry.closure, evokation, x, w);
+  case CallKind_monad:
+    return entry.monad(x);
+  case CallKind_dyad:
+    return entry.dyad(x, w);
+  case CallKind_m1_monad:
+    return entry.m1_monad(entry.f, x);
+  case CallKind_m1_dyad:
+    return entry.m1_dyad(entry.f, x, w);
+  case CallKind_m2_monad:
+    return entry.m2_monad(entry.f, entry.g, x);
+  case CallKind_m2_dyad:
+    return entry.m2_dyad(entry.f, entry.g, x, w);
+  default:
+    return fern_evoke(f, evokation, x, w);
+  }
+}
+
 // Stack --------------------------------------------------------------------------------------------------------------
+// the value stack of a run is a slice of one contiguous stack, as deep as the bytecode of the run can need. a run takes its
+// slice at the top and gives it back when it returns, so the innermost run can resize its slice in place. the env a run
+// of a frame owns is kept by depth of the run next to it: a ⎊ that catches a throw out of a block never sees the runs in
+// between return, and gives back their slices and envs with fern_internal_vm_restore
+#define VM_STACK_SIZE (1 << 20)
+
+static fern_Box * vm_stack;
+static uint32_t vm_stack_top;
+static struct Env ** vm_frames; // NULL for a run without a frame
+static uint32_t vm_frames_top;
+
 struct Stack {
   uint32_t s_length;
-  uint32_t s_capacity;
   fern_Box * s;
+  uint32_t frame; // of the run in vm_frames
   bool cont;
+  bool skip; // a header rejected the arguments, the next body is tried
   fern_Box rslt;
 };
 
-static inline void Stack_init(struct Stack * stack, uint32_t initial_length, fern_Box * initial) {
+static inline void Stack_resize(struct Stack * stack, uint32_t depth) {
+  uint32_t base = stack->s - vm_stack;
+  fern_assert_fatal_error(depth <= VM_STACK_SIZE - base, "Stack overflow");
+  vm_stack_top = base + depth;
+}
+
+static inline void Stack_init(struct Stack * stack, uint32_t depth, struct Env * owned) {
+  if(vm_stack == NULL) {
+    vm_stack = malloc(sizeof(*vm_stack) * VM_STACK_SIZE);
+    vm_frames = malloc(sizeof(*vm_frames) * VM_STACK_SIZE);
+  }
+  fern_assert_fatal_error(vm_frames_top < VM_STACK_SIZE, "Stack overflow");
+  stack->frame = vm_frames_top++;
+  vm_frames[stack->frame] = owned;
   stack->s_length = 0;
-  stack->s_capacity = 0;
-  stack->s = NULL;
+  stack->s = vm_stack + vm_stack_top;
+  Stack_resize(stack, depth);
   stack->cont = true;
+  stack->skip = false;
   stack->rslt = fern_COMMERCIAL_AT();
 }
 
-static inline void Stack_push(struct Stack * stack, fern_Box value) {
-  if(stack->s_length + 1 >= stack->s_capacity) {
-    stack->s_capacity = (stack->s_length + 1);
-    stack->s_capacity += stack->s_capacity >> 1;
-    stack->s = realloc(stack->s, sizeof(*stack->s) * stack->s_capacity);
+static inline void Stack_tini(struct Stack * stack) {
+  vm_stack_top = stack->s - vm_stack;
+  vm_frames_top = stack->frame;
+}
+
+// the run entered another body or tail called, and owns the env of that now
+static inline void Stack_own(struct Stack * stack, struct Env * e) {
+  vm_frames[stack->frame] = e;
+}
+
+fern_VMState fern_internal_vm_save(void) {
+  return (fern_VMState){ .stack_top = vm_stack_top, .frames_top = vm_frames_top };
+}
+
+void fern_internal_vm_restore(fern_VMState state) {
+  while(vm_frames_top > state.frames_top) {
+    struct Env * e = vm_frames[--vm_frames_top];
+    if(e != NULL) {
+      Object_free((union Object *)e);
+    }
   }
+  vm_stack_top = state.stack_top;
+}
+
+static inline void Stack_push(struct Stack * stack, fern_Box value) {
   stack->s[stack->s_length++] = value;
 }
 
 static inline fern_Box * Stack_pop(struct Stack * stack, uint32_t count) {
-  fern_assert_fatal_error(count < stack->s_length, "internal error");
+  fern_assert_fatal_error(count <= stack->s_length, "internal error");
   stack->s_length -= count;
   return stack->s + stack->s_length;
 }
@@ -561,38 +856,618 @@ static inline void Stack_ret(struct Stack * stack, fern_Box x, uint32_t w) {
 
 static inline void Stack_skip(struct Stack * stack) {
   stack->cont = false;
+  stack->skip = true;
+}
+
+// Frame --------------------------------------------------------------------------------------------------------------
+// a call of a block: the values of its special variables, in order those of 𝕤 𝕩 𝕨 𝕣 𝕗 𝕘 that the kind of block has, and
+// the bodies still to try
+struct Frame {
+  struct Env * parent;
+  uint32_t * bodies;
+  uint32_t num_bodies;
+  uint32_t max_stack; // of the body entered last
+  uint32_t num_special;
+  fern_Box special[6];
+};
+
+static void Frame_init(struct Frame * frame, struct Env * parent, uint32_t index, fern_Evokation evokation) {
+  struct Block * block = parent->program->blocks + index;
+  frame->parent = parent;
+  frame->bodies = block->bodies;
+  frame->num_bodies = block->num_bodies;
+  if(block->num_bodies > 1) {
+    frame->num_bodies /= 2;
+    if(evokation == fern_Evokation_dyad) {
+      frame->bodies += frame->num_bodies;
+    }
+  }
+  frame->num_special = 0;
+}
+
+static inline void Frame_special(struct Frame * frame, fern_Box value) {
+  frame->special[frame->num_special++] = value;
+}
+
+// the frame of a call of f when it is a block function or is derived from a block modifier
+static bool Frame_callee(struct Frame * frame, fern_Box f, fern_Evokation evokation, fern_Box x, fern_Box w) {
+  if(!fern_is_function(f) || evokation > fern_Evokation_dyad) {
+    return false;
+  }
+  fern_Function function = fern_unpack_function(f);
+  fern_Box m = fern_nothing(), g = fern_nothing();
+  switch(function->type) {
+  case fern_FunctionType_block:
+    Frame_init(frame, function->block.env, function->block.index, evokation);
+    break;
+  case fern_FunctionType_applied_m1:
+    m = function->applied_m1.m;
+    if(fern_unpack_modifier1(m)->type != fern_Modifier1Type_block) {
+      return false;
+    }
+    Frame_init(frame, fern_unpack_modifier1(m)->block.env, fern_unpack_modifier1(m)->block.index, evokation);
+    break;
+  case fern_FunctionType_applied_m2:
+    m = function->applied_m2.m;
+    if(fern_unpack_modifier2(m)->type != fern_Modifier2Type_block) {
+      return false;
+    }
+    Frame_init(frame, fern_unpack_modifier2(m)->block.env, fern_unpack_modifier2(m)->block.index, evokation);
+    g = function->applied_m2.g;
+    break;
+  default:
+    return false;
+  }
+  Frame_special(frame, f);
+  Frame_special(frame, x);
+  Frame_special(frame, evokation == fern_Evokation_dyad ? w : fern_nothing());
+  if(function->type != fern_FunctionType_block) {
+    Frame_special(frame, m);
+    Frame_special(frame, function->type == fern_FunctionType_applied_m1 ? function->applied_m1.f : function->applied_m2.f);
+  }
+  if(function->type == fern_FunctionType_applied_m2) {
+    Frame_special(frame, g);
+  }
+  return true;
+}
+
+// a new env for the next body of the frame, with the special variables set, and where its bytecode starts
+static struct Env * Frame_enter(struct Frame * frame, uint32_t ** bc, uint32_t * pos) {
+  while(frame->num_bodies > 0 && *frame->bodies == (uint32_t)-1) {
+    frame->bodies++;
+    frame->num_bodies--;
+  }
+  fern_assert_fatal_error(frame->num_bodies > 0, "No header matched the arguments");
+  struct Program * program = frame->parent->program;
+  struct Body * body = program->bodies + *frame->bodies;
+  frame->bodies++;
+  frame->num_bodies--;
+  struct Env * e = Env_allocate(body->num_vars);
+  Env_init(e, frame->parent, body->num_vars, body->names, body->num_names);
+  for(uint32_t i = 0; i < frame->num_special; i++) {
+    Var_set_n(e->vars + i, frame->special[i]);
+  }
+  *bc = program->bc;
+  *pos = body->start;
+  frame->max_stack = body->max_stack;
+  return e;
 }
 
 // ops ----------------------------------------------------------------------------------------------------------------
+// `a F↩ b` is `a ↩ a F b` and `a F↩` is `a ↩ F a`. a monadic `a 𝔽⌾𝔾↩` hands the value of a to ⌾ when a owns it, so ⌾ can
+// write into it. a owns it when the last assignment was such a ⌾ that built it, nothing read a since, and the assignment
+// result was dropped rather than kept. the dyadic form builds its result from b, not a, so it is never handed a
+static inline bool modify_owned(union Object * object, fern_Box f) {
+  if(object->type != ObjectType_var_set || !object->var.owned || !fern_is_function(f)) {
+    return false;
+  }
+  fern_Function function = fern_unpack_function(f);
+  return function->type == fern_FunctionType_applied_c_m2
+      && function->applied_c_m2.m == fern_unpack_modifier2(fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_JOT())->c;
+}
+
+static inline fern_Box modify(union Object * object, fern_Box f, fern_Evokation evokation, fern_Box x, bool dropped) {
+  bool owned = evokation == fern_Evokation_monad && modify_owned(object, f);
+  fern_Box value = Object_get(object, fern_COMMERCIAL_AT());
+  fern_internal_owned = owned ? value : fern_nil();
+  fern_internal_fresh = fern_nil();
+  fern_Box result = evokation == fern_Evokation_monad ? fern_evoke(f, evokation, value, x) : fern_evoke(f, evokation, x, value);
+  fern_internal_owned = fern_nil();
+  result = Object_set_u(object, result);
+  if(object->type == ObjectType_var_set) {
+    object->var.owned = dropped && result.bits == fern_internal_fresh.bits;
+  }
+  return result;
+}
+
+// quickening ---------------------------------------------------------------------------------------------------------
+// the first run of an application of a scalar primitive rewrites its op to the quick op for that primitive. a quick op does
+// number-number arithmetic inline while the callee is still that primitive, and is an ordinary application otherwise. a NaN
+// result also goes through the primitive, which reports the error
+#define OP_QUICK_MONAD 128 // + fern_ScalarOp, quickened 16
+#define OP_QUICK_DYAD  144 // + fern_ScalarOp, quickened 17
+
+#define QUICK_CASES(BASE) \
+    case BASE + fern_ScalarOp_add: \
+    case BASE + fern_ScalarOp_multiply: \
+    case BASE + fern_ScalarOp_max: \
+    case BASE + fern_ScalarOp_min: \
+    case BASE + fern_ScalarOp_or: \
+    case BASE + fern_ScalarOp_and: \
+    case BASE + fern_ScalarOp_not_equal: \
+    case BASE + fern_ScalarOp_subtract: \
+    case BASE + fern_ScalarOp_divide: \
+    case BASE + fern_ScalarOp_equal:
+
+static fern_Box quick_callee[fern_ScalarOp_equal + 1];
+
+static inline uint32_t quicken(uint32_t op, fern_Box f) {
+  fern_ScalarOp scalar = fern_internal_scalar_op(f);
+  if(scalar == fern_ScalarOp_none || (op == 16 && !fern_internal_scalar_monad_op(scalar))) {
+    return op;
+  }
+  quick_callee[scalar] = f;
+  return (op == 16 ? OP_QUICK_MONAD : OP_QUICK_DYAD) + scalar;
+}
+
+static inline bool quick_monad(fern_ScalarOp scalar, double x, double * r) {
+  switch(scalar) {
+  case fern_ScalarOp_add:      *r = x;                                                        break;
+  case fern_ScalarOp_subtract: *r = -x;                                                       break;
+  case fern_ScalarOp_multiply: *r = copysign(fpclassify(x) == FP_ZERO ? 0 : 1, x);            break;
+  case fern_ScalarOp_divide:   *r = 1 / x;                                                    break;
+  case fern_ScalarOp_max:      *r = ceil(x);                                                  break;
+  case fern_ScalarOp_min:      *r = floor(x);                                                 break;
+  default:                     return false;
+  }
+  return !isnan(*r);
+}
+
+static inline bool quick_dyad(fern_ScalarOp scalar, double x, double w, double * r) {
+  switch(scalar) {
+  case fern_ScalarOp_add:       *r = w + x;             break;
+  case fern_ScalarOp_subtract:  *r = w - x;             break;
+  case fern_ScalarOp_multiply:
+  case fern_ScalarOp_and:       *r = x * w;             break;
+  case fern_ScalarOp_divide:    *r = w / x;             break;
+  case fern_ScalarOp_max:       *r = fmax(x, w);        break;
+  case fern_ScalarOp_min:       *r = fmin(x, w);        break;
+  case fern_ScalarOp_or:        *r = (x + w) - x * w;   break;
+  case fern_ScalarOp_equal:     *r = x == w;            break;
+  case fern_ScalarOp_not_equal: *r = x != w;            break;
+  default:                      return false;
+  }
+  return !isnan(*r);
+}
+
+// once the run of a frame stops, its env is freed, and the next body entered when a header rejected the arguments
+static inline bool Frame_next(struct Frame * frame, struct Stack * s, struct Env ** e, uint32_t ** bc, uint32_t * pos) {
+  if(frame == NULL) {
+    return false;
+  }
+  Object_free((union Object *)*e);
+  if(!s->skip) {
+    return false;
+  }
+  *e = Frame_enter(frame, bc, pos);
+  Stack_own(s, *e);
+  Stack_resize(s, frame->max_stack);
+  s->s_length = 0;
+  s->cont = true;
+  s->skip = false;
+  return true;
+}
+
+// stack depth --------------------------------------------------------------------------------------------------------
+// the op and its operands
+static inline uint32_t op_length(uint32_t op) {
+  switch(op) {
+  case 0: case 1: case 11: case 12: case 64: case 66:
+    return 2;
+  case 32: case 33: case 34:
+    return 3;
+  default:
+    return 1;
+  }
+}
+
+// the deepest the value stack gets running the bytecode at pos up to its return. bodies have no jumps, and a rejecting
+// header only stops a body early
+static uint32_t max_stack(uint32_t * bc, uint32_t pos, uint32_t end) {
+  int32_t depth = 0, result = 0;
+  while(pos < end) {
+    switch(bc[pos]) {
+    case 0: case 1: case 32: case 33: case 34: case 44:
+      depth += 1;
+      break;
+    case 6: case 18: case 20: case 26: case 42: case 48: case 49: case 51:
+      depth -= 1;
+      break;
+    case 16: QUICK_CASES(OP_QUICK_MONAD)
+      depth -= 1;
+      break;
+    case 17: QUICK_CASES(OP_QUICK_DYAD)
+    case 19: case 21: case 23: case 27: case 47: case 50:
+      depth -= 2;
+      break;
+    case 11: case 12:
+      depth += 1 - (int32_t)bc[pos + 1];
+      break;
+    case 7: case 8:
+      return result;
+    }
+    result = depth > result ? depth : result;
+    pos += op_length(bc[pos]);
+  }
+  return result;
+}
+
+// chain fusion -------------------------------------------------------------------------------------------------------
+// the scalar primitives only take atoms, arrays go through F¨. an application of F¨ to an array looks ahead for more
+// applications of scalar primitives under ¨ taking its result, their other arguments constants, variables or values
+// already on the stack. the applications up to the last one that leaves nothing but its result become one
+// fern_ScalarProgram over the arrays read, run by fern_internal_scalar_fused so no intermediate array is made. a chain of
+// one application, arrays of differing shapes, empty or with cells other than numbers are left to ¨. while looking ahead
+// an operand is tagged by its kind, numbered as fern_ScalarProgram has them once the chain ends
+#define FUSE_VALUE UINT8_MAX // not a step, its operand not known yet
+#define FUSE_CONST 0x40
+#define FUSE_STEP  0x80
+
+struct FuseItem {
+  fern_Box value;
+  uint8_t operand;
+};
 
+struct Fuse {
+  fern_ScalarProgram program;
+  uint32_t num_inputs;
+  fern_Array arrays[fern_CLOSURE_MAX];
+  uint32_t num_vars;
+  struct Var * vars[fern_CLOSURE_MAX];
+};
+
+static uint8_t Fuse_operand(struct Fuse * fuse, struct FuseItem item) {
+  if(item.operand != FUSE_VALUE) {
+    return item.operand;
+  }
+  if(fern_is_number(item.value)) {
+    fern_ScalarProgram * program = &fuse->program;
+    for(uint32_t k = 0; k < program->num_consts; k++) {
+      if(fern_pack_number(program->consts[k]).bits == item.value.bits) {
+        return FUSE_CONST | k;
+      }
+    }
+    if(program->num_consts == fern_CLOSURE_MAX) {
+      return FUSE_VALUE;
+    }
+    program->consts[program->num_consts] = item.value.number;
+    return FUSE_CONST | program->num_consts++;
+  }
+  if(!fern_is_array(item.value)) {
+    return FUSE_VALUE;
+  }
+  fern_Array array = fern_unpack_array(item.value);
+  for(uint32_t k = 0; k < fuse->num_inputs; k++) {
+    if(fuse->arrays[k] == array) {
+      return k;
+    }
+  }
+  fern_ArrayReader reader = fern_read_array(array);
+  if(fuse->num_inputs == fern_CLOSURE_MAX || reader.cells.size == 0 || !fern_array_complete(reader) ||
+     (fuse->num_inputs > 0 && !fern_internal_match_shape(fuse->arrays[0], array))) {
+    return FUSE_VALUE;
+  }
+  fuse->arrays[fuse->num_inputs] = array;
+  return fuse->num_inputs++;
+}
+
+static bool Fuse_step(struct Fuse * fuse, struct FuseItem f, bool monad, struct FuseItem x, struct FuseItem w, struct FuseItem * result) {
+  fern_ScalarOp op = f.operand == FUSE_VALUE ? fern_internal_scalar_each_op(f.value) : fern_ScalarOp_none;
+  if(op == fern_ScalarOp_none || (monad && !fern_internal_scalar_monad_op(op)) || fuse->program.num_steps == fern_CLOSURE_MAX) {
+    return false;
+  }
+  uint8_t x_operand = Fuse_operand(fuse, x);
+  uint8_t w_operand = monad ? x_operand : Fuse_operand(fuse, w);
+  if(x_operand == FUSE_VALUE || w_operand == FUSE_VALUE) {
+    return false;
+  }
+  uint32_t i = fuse->program.num_steps++;
+  fuse->program.steps[i] = (fern_ScalarStep){ .op = op, .monad = monad, .x = x_operand, .w = w_operand };
+  *result = (struct FuseItem){ .value = fern_nil(), .operand = FUSE_STEP | i };
+  return true;
+}
+
+static inline bool is_application(uint32_t op, bool monad) {
+  uint32_t quick = monad ? OP_QUICK_MONAD : OP_QUICK_DYAD;
+  return op == (monad ? 16 : 17) || (op >= quick && op <= quick + fern_ScalarOp_equal);
+}
+
+// the application of f just popped from s, then the chain after it at pos. on success the result of the chain is pushed in
+// place of what it took from s, and pos is past its last application
+static bool fuse_chain(struct Stack * s, struct Env * e, uint32_t * bc, uint32_t * pos, fern_Box f, bool monad, fern_Box x, fern_Box w) {
+  struct Fuse fuse = { .program = { .num_consts = 0, .num_steps = 0 }, .num_inputs = 0, .num_vars = 0 };
+  // what the lookahead pushed, and how many values below it on s its applications took
+  struct FuseItem items[fern_CLOSURE_MAX];
+  uint32_t num_items = 1, taken = 0;
+  if(!Fuse_step(&fuse, (struct FuseItem){ f, FUSE_VALUE }, monad, (struct FuseItem){ x, FUSE_VALUE }, (struct FuseItem){ w, FUSE_VALUE }, items)) {
+    return false;
+  }
+
+  struct Fuse end = fuse;
+  uint32_t end_pos = *pos, end_taken = 0;
+  for(uint32_t p = *pos; ; ) {
+    uint32_t op = bc[p];
+    if(op == 0 || op == 32) {
+      fern_Box value = e->program->consts[bc[p + 1]];
+      if(op == 32) {
+        struct Env * voe = e;
+        for(uint32_t d = bc[p + 1]; d > 0; d--) {
+          voe = voe->parent;
+        }
+        struct Var * v = voe->vars + bc[p + 2];
+        if(v->type != ObjectType_var_set || fuse.num_vars == fern_CLOSURE_MAX) {
+          break;
+        }
+        fuse.vars[fuse.num_vars++] = v;
+        value = v->value;
+      }
+      if(num_items == fern_CLOSURE_MAX) {
+        break;
+      }
+      items[num_items++] = (struct FuseItem){ value, FUSE_VALUE };
+      p += op_length(op);
+      continue;
+    }
+
+    bool app_monad = is_application(op, true);
+    uint32_t arity = app_monad ? 2 : 3;
+    if((!app_monad && !is_application(op, false)) || num_items + s->s_length - taken < arity) {
+      break;
+    }
+    // w f x, the ones not pushed by the lookahead from below it on s
+    struct FuseItem args[3];
+    for(uint32_t k = 0; k < arity; k++) {
+      args[arity - 1 - k] = k < num_items ? items[num_items - 1 - k] : (struct FuseItem){ s->s[s->s_length - 1 - taken - (k - num_items)], FUSE_VALUE };
+    }
+    taken += arity > num_items ? arity - num_items : 0;
+    num_items = arity > num_items ? 0 : num_items - arity;
+    if(!Fuse_step(&fuse, args[arity - 2], app_monad, args[arity - 1], args[0], items + num_items)) {
+      break;
+    }
+    num_items++;
+    p++;
+    if(num_items == 1) {
+      end = fuse;
+      end_pos = p;
+      end_taken = taken;
+    }
+  }
+  if(end.program.num_steps < 2) {
+    return false;
+  }
+
+  fern_ScalarProgram * program = &end.program;
+  #define _OPERAND(T) ((T) < FUSE_CONST ? (T) : (T) < FUSE_STEP ? end.num_inputs + ((T) & 0x3F) : end.num_inputs + program->num_consts + ((T) & 0x3F))
+  for(uint32_t i = 0; i < program->num_steps; i++) {
+    program->steps[i].x = _OPERAND(program->steps[i].x);
+    program->steps[i].w = _OPERAND(program->steps[i].w);
+  }
+  program->result = _OPERAND(FUSE_STEP | (program->num_steps - 1));
+  #undef _OPERAND
+  // a fern_DataReader has const members, it is copied in rather than assigned
+  fern_DataReader * inputs = malloc(sizeof(*inputs) * end.num_inputs);
+  for(uint32_t k = 0; k < end.num_inputs; k++) {
+    fern_DataReader cells = fern_read_data(&end.arrays[k]->cells);
+    memcpy(inputs + k, &cells, sizeof(cells));
+  }
+  union fern_Data data;
+  bool fused = fern_internal_scalar_fused(program, inputs, end.num_inputs, &data);
+  free(inputs);
+  if(!fused) {
+    return false;
+  }
+
+  for(uint32_t k = 0; k < end.num_vars; k++) {
+    Var_get(end.vars[k], fern_COMMERCIAL_AT());
+  }
+  for(uint32_t k = 0; k < end_taken; k++) {
+    fern_free(s->s[s->s_length - 1 - k]);
+  }
+  s->s_length -= end_taken;
+  Stack_push(s, fern_mk_array(&end.arrays[0]->shape, &data, fern_DIGIT_ZERO()));
+  *pos = end_pos;
+  return true;
+}
+
+// blocks -------------------------------------------------------------------------------------------------------------
+static fern_Box run(uint32_t * bc, uint32_t pos, struct Env * e, struct Frame * frame);
+
+static fern_Box Frame_run(struct Frame * frame) {
+  uint32_t * bc;
+  uint32_t pos;
+  struct Env * e = Frame_enter(frame, &bc, &pos);
+  return run(bc, pos, e, frame);
+}
+
+fern_Box fern_evoke_block(fern_Box evokable, fern_Evokation evokation, fern_Box x, fern_Box w) {
+  struct Frame frame;
+  if(!Frame_callee(&frame, evokable, evokation, x, w)) {
+    fern_fatal_error("not implemented");
+  }
+  return Frame_run(&frame);
+}
+
+static inline struct Block * Block_of(void * env, uint32_t index) {
+  return ((struct Env *)env)->program->blocks + index;
+}
+
+// an immediate function block runs now, any other block becomes a function or modifier that holds on to e
+static fern_Box Block_define(struct Env * e, uint32_t index) {
+  struct Block * block = Block_of(e, index);
+  switch(block->type) {
+  case 0:
+    if(block->immediate) {
+      struct Frame frame;
+      Frame_init(&frame, e, index, fern_Evokation_monad);
+      return Frame_run(&frame);
+    } else {
+      fern_Function function = fern_allocate_function();
+      function->type = fern_FunctionType_block;
+      function->block.env = Object_clone((union Object *)e);
+      function->block.index = index;
+      return fern_pack_function(function);
+    }
+  case 1:
+    {
+      fern_Modifier1 modifier1 = fern_allocate_modifier1();
+      modifier1->type = fern_Modifier1Type_block;
+      modifier1->block.env = Object_clone((union Object *)e);
+      modifier1->block.index = index;
+      return fern_pack_modifier1(modifier1);
+    }
+  case 2:
+    {
+      fern_Modifier2 modifier2 = fern_allocate_modifier2();
+      modifier2->type = fern_Modifier2Type_block;
+      modifier2->block.env = Object_clone((union Object *)e);
+      modifier2->block.index = index;
+      return fern_pack_modifier2(modifier2);
+    }
+  default:
+    fern_fatal_error("unknown block type");
+  }
+}
+
+// an immediate block modifier runs when it is applied, with 𝕣 𝕗 and 𝕘
+static fern_Box Block_apply(void * env, uint32_t index, fern_Box m, fern_Box f, fern_Box g) {
+  struct Frame frame;
+  Frame_init(&frame, env, index, fern_Evokation_monad);
+  Frame_special(&frame, m);
+  Frame_special(&frame, f);
+  if(fern_is_modifier2(m)) {
+    Frame_special(&frame, g);
+  }
+  return Frame_run(&frame);
+}
+
+// run ----------------------------------------------------------------------------------------------------------------
+#define OP_COUNT 256
+
+#if BQN_THREADED
+// the handlers of the threaded interpreter by op, set by a run without bytecode
+static const void ** op_handlers;
+#endif
+
+// the program of e has been through Program_prepare and bc is its bytecode
 fern_Box run_bc(uint32_t * bc, uint32_t pos, struct Env * e) {
+  return run(bc, pos, e, NULL);
+}
+
+// e belongs to the run when there is a frame, which is the call of a block, and is freed once a body returns or a header
+// rejects the arguments. an application right before a return that calls a block is a tail call: the frame is swapped for
+// that of the callee and the loop goes on in the body of the callee
+static fern_Box run(uint32_t * bc, uint32_t pos, struct Env * e, struct Frame * frame) {
+  #if BQN_THREADED
+  static const void * handlers[OP_COUNT] = {
+      [0 ... OP_COUNT - 1] = &&op_unknown
+    , [0] = &&op_0
+    , [1] = &&op_1
+    , [6] = &&op_6
+    , [7] = &&op_7
+    , [8] = &&op_8
+    , [11] = &&op_11
+    , [12] = &&op_12
+    , [16] = &&op_16
+    , [17] = &&op_17
+    , [18] = &&op_18
+    , [19] = &&op_19
+    , [20] = &&op_20
+    , [21] = &&op_21
+    , [22] = &&op_22
+    , [23] = &&op_23
+    , [26] = &&op_26
+    , [27] = &&op_27
+    , [32] = &&op_32
+    , [33] = &&op_33
+    , [34] = &&op_34
+    , [42] = &&op_42
+    , [43] = &&op_43
+    , [44] = &&op_44
+    , [47] = &&op_47
+    , [48] = &&op_48
+    , [49] = &&op_49
+    , [50] = &&op_50
+    , [51] = &&op_51
+    , [64] = &&op_64
+    , [66] = &&op_66
+    , [OP_QUICK_MONAD ... OP_QUICK_MONAD + fern_ScalarOp_equal] = &&op_quick_monad
+    , [OP_QUICK_DYAD ... OP_QUICK_DYAD + fern_ScalarOp_equal] = &&op_quick_dyad
+  };
+  if(bc == NULL) {
+    op_handlers = handlers;
+    return fern_nothing();
+  }
+  #endif
+
   struct Stack s;
-  Stack_init(&s, 0, NULL);
+  struct Frame tail;
+  Stack_init(&s, frame != NULL ? frame->max_stack : max_stack(bc, pos, e->program->num_bc), frame != NULL ? e : NULL);
 
   #define NEXT (bc[pos++])
+  #if BQN_THREADED
+  // the op has a label besides its case, the threaded code jumps from handler to handler
+  #define OP(N) case N: op_##N:
+  #define OP_LABEL(NAME) op_##NAME:
+  #define DISPATCH() op = NEXT; goto *th[pos - 1]
+  #define RETHREAD(P) th[P] = handlers[bc[P]]
+  #else
+  #define OP(N) case N:
+  #define OP_LABEL(NAME)
+  #define DISPATCH() break
+  #define RETHREAD(P)
+  #endif
+  // the cache of the application whose op was just read
+  #define CALL_CACHE (Program_call_cache(e->program, pos - 1))
+  // an application about to be returned, of a block
+  #define TAIL_CALL(F, EVOKATION, X, W) (bc[pos] == 7 && Frame_callee(&tail, F, EVOKATION, X, W))
+  #define ENTER_TAIL_CALL() \
+    if(frame != NULL) { \
+      Object_free((union Object *)e); \
+    } \
+    frame = &tail; \
+    e = Frame_enter(frame, &bc, &pos); \
+    Stack_own(&s, e); \
+    Stack_resize(&s, frame->max_stack);
 
-  while(s.cont) {
-    uint32_t op = NEXT, op_a, op_b;
+  while(s.cont || Frame_next(frame, &s, &e, &bc, &pos)) {
+    uint32_t op, op_a, op_b;
     struct Var * v;
-    
+    #if BQN_THREADED
+    const void ** th = e->program->threaded;
+    DISPATCH();
+    #else
+    op = NEXT;
+    #endif
+
     switch(op) {
     // CONSTANTS AND DROP
-    case 0:
+    OP(0)
       op_a = NEXT;
       Stack_push(&s, e->program->consts[op_a]);
-      break;
-    case 1:
-      // TODO
-      break;
-    case 6:
+      DISPATCH();
+    OP(1)
+      op_a = NEXT;
+      Stack_push(&s, Block_define(e, op_a));
+      DISPATCH();
+    OP(6)
       Stack_pop(&s, 1);
-      break;
+      DISPATCH();
 
     // RETURNS
-    case 7:
+    OP(7)
       Stack_ret(&s, *Stack_pop(&s, 1), 0);
       break;
-    case 8:
+    OP(8)
       {
         struct NS * ns = NS_allocate();
         NS_init(ns, e);
@@ -601,7 +1476,7 @@ fern_Box run_bc(uint32_t * bc, uint32_t pos, struct Env * e) {
       break;
 
     // ARRAYS
-    case 11:
+    OP(11)
       op_a = NEXT;
       fern_Box * src = Stack_pop(&s, op_a);
       {
@@ -611,45 +1486,97 @@ fern_Box run_bc(uint32_t * bc, uint32_t pos, struct Env * e) {
         memcpy(dst, src, sizeof(*dst) * op_a);
         Stack_push(&s, fern_pack_array(result));
       }
-      break;
-    case 12:
+      DISPATCH();
+    OP(12)
       op_a = NEXT;
       {
         struct Array * result = Array_allocate(op_a);
-        Array_init(result, op_a, src);
+        Array_init(result, op_a, Stack_pop(&s, op_a));
         Stack_push(&s, fern_pack_namespace((fern_Namespace)result));
       }
-      break;
+      DISPATCH();
 
     // APPLICATION
-    case 16:
+    OP(16)
       {
         fern_Box * f_x = Stack_pop(&s, 2);
-        Stack_push(&s, fern_evoke(f_x[0], fern_Evokation_monad, f_x[1], fern_nothing()));
+        if(TAIL_CALL(f_x[0], fern_Evokation_monad, f_x[1], fern_nothing())) {
+          ENTER_TAIL_CALL()
+          break;
+        }
+        struct CallCache * cache = CALL_CACHE;
+        if(cache->length == 0) {
+          bc[pos - 1] = quicken(op, f_x[0]);
+          RETHREAD(pos - 1);
+        }
+        if(!fern_is_array(f_x[1]) || !fuse_chain(&s, e, bc, &pos, f_x[0], true, f_x[1], f_x[1])) {
+          Stack_push(&s, CallCache_evoke(cache, f_x[0], fern_Evokation_monad, f_x[1], fern_nothing()));
+        }
         fern_free(f_x[0]);
         fern_free(f_x[1]);
       }
-      break;
-    case 17:
+      DISPATCH();
+    OP(17)
       {
         fern_Box * w_f_x = Stack_pop(&s, 3);
-        Stack_push(&s, fern_evoke(w_f_x[1], fern_Evokation_dyad, w_f_x[2], w_f_x[0]));
+        if(TAIL_CALL(w_f_x[1], fern_Evokation_dyad, w_f_x[2], w_f_x[0])) {
+          ENTER_TAIL_CALL()
+          break;
+        }
+        struct CallCache * cache = CALL_CACHE;
+        if(cache->length == 0) {
+          bc[pos - 1] = quicken(op, w_f_x[1]);
+          RETHREAD(pos - 1);
+        }
+        if((!fern_is_array(w_f_x[2]) && !fern_is_array(w_f_x[0])) || !fuse_chain(&s, e, bc, &pos, w_f_x[1], false, w_f_x[2], w_f_x[0])) {
+          Stack_push(&s, CallCache_evoke(cache, w_f_x[1], fern_Evokation_dyad, w_f_x[2], w_f_x[0]));
+        }
         fern_free(w_f_x[0]);
         fern_free(w_f_x[1]);
         fern_free(w_f_x[2]);
       }
-      break;
-    case 20:
+      DISPATCH();
+    QUICK_CASES(OP_QUICK_MONAD) OP_LABEL(quick_monad)
+      {
+        fern_Box * f_x = Stack_pop(&s, 2);
+        fern_ScalarOp scalar = op - OP_QUICK_MONAD;
+        double r;
+        if(f_x[0].bits == quick_callee[scalar].bits && fern_is_number(f_x[1]) && quick_monad(scalar, f_x[1].number, &r)) {
+          Stack_push(&s, fern_pack_number(r));
+        } else if(!fern_is_array(f_x[1]) || !fuse_chain(&s, e, bc, &pos, f_x[0], true, f_x[1], f_x[1])) {
+          Stack_push(&s, CallCache_evoke(CALL_CACHE, f_x[0], fern_Evokation_monad, f_x[1], fern_nothing()));
+        }
+        fern_free(f_x[0]);
+        fern_free(f_x[1]);
+      }
+      DISPATCH();
+    QUICK_CASES(OP_QUICK_DYAD) OP_LABEL(quick_dyad)
+      {
+        fern_Box * w_f_x = Stack_pop(&s, 3);
+        fern_ScalarOp scalar = op - OP_QUICK_DYAD;
+        double r;
+        if(w_f_x[1].bits == quick_callee[scalar].bits && fern_is_number(w_f_x[2]) && fern_is_number(w_f_x[0]) && quick_dyad(scalar, w_f_x[2].number, w_f_x[0].number, &r)) {
+          Stack_push(&s, fern_pack_number(r));
+        } else if((!fern_is_array(w_f_x[2]) && !fern_is_array(w_f_x[0])) || !fuse_chain(&s, e, bc, &pos, w_f_x[1], false, w_f_x[2], w_f_x[0])) {
+          Stack_push(&s, CallCache_evoke(CALL_CACHE, w_f_x[1], fern_Evokation_dyad, w_f_x[2], w_f_x[0]));
+        }
+        fern_free(w_f_x[0]);
+        fern_free(w_f_x[1]);
+        fern_free(w_f_x[2]);
+      }
+      DISPATCH();
+    OP(20)
       {
         fern_Box * g_h = Stack_pop(&s, 2);
         fern_Function result = fern_allocate_function();
         result->type = fern_FunctionType_train2;
         result->train2.g = g_h[0];
         result->train2.h = g_h[1];
+        fern_internal_compile_function(result);
         Stack_push(&s, fern_pack_function(result));
       }
-      break;
-    case 21:
+      DISPATCH();
+    OP(21)
       {
         fern_Box * f_g_h = Stack_pop(&s, 3);
         fern_Function result = fern_allocate_function();
@@ -657,18 +1584,28 @@ fern_Box run_bc(uint32_t * bc, uint32_t pos, struct Env * e) {
         result->train3.f = f_g_h[0];
         result->train3.g = f_g_h[1];
         result->train3.h = f_g_h[2];
+        fern_internal_compile_function(result);
         Stack_push(&s, fern_pack_function(result));
       }
-      break;
-    case 26:
+      DISPATCH();
+    OP(26)
       {
         fern_Box * f_m = Stack_pop(&s, 2);
-        fern_Function result = fern_allocate_function();
         fern_Modifier1 m = fern_unpack_modifier1(f_m[1]);
+        if(m->type == fern_Modifier1Type_block && Block_of(m->block.env, m->block.index)->immediate) {
+          Stack_push(&s, Block_apply(m->block.env, m->block.index, f_m[1], f_m[0], fern_nothing()));
+          DISPATCH();
+        }
+        fern_Function result = fern_allocate_function();
         if(m->type == fern_Modifier1Type_c) {
           result->type = fern_FunctionType_applied_c_m1;
           result->applied_c_m1.f = f_m[0];
           result->applied_c_m1.m = m->c;
+          result->applied_c_m1.monad = m->monad;
+          result->applied_c_m1.dyad = m->dyad;
+          result->applied_c_m1.inverse = m->inverse;
+          result->applied_c_m1.emit = m->emit;
+          fern_internal_recognize_idiom(result);
         } else {
           result->type = fern_FunctionType_applied_m1;
           result->applied_m1.f = f_m[0];
@@ -676,53 +1613,63 @@ fern_Box run_bc(uint32_t * bc, uint32_t pos, struct Env * e) {
         }
         Stack_push(&s, fern_pack_function(result));
       }
-      break;
-    case 27:
+      DISPATCH();
+    OP(27)
       {
         fern_Box * f_m_g = Stack_pop(&s, 3);
-        fern_Function result = fern_allocate_function();
         fern_Modifier2 m = fern_unpack_modifier2(f_m_g[1]);
+        if(m->type == fern_Modifier2Type_block && Block_of(m->block.env, m->block.index)->immediate) {
+          Stack_push(&s, Block_apply(m->block.env, m->block.index, f_m_g[1], f_m_g[0], f_m_g[2]));
+          DISPATCH();
+        }
+        fern_Function result = fern_allocate_function();
         if(m->type == fern_Modifier2Type_c) {
           result->type = fern_FunctionType_applied_c_m2;
           result->applied_c_m2.f = f_m_g[0];
           result->applied_c_m2.m = m->c;
           result->applied_c_m2.g = f_m_g[2];
+          result->applied_c_m2.monad = m->monad;
+          result->applied_c_m2.dyad = m->dyad;
+          result->applied_c_m2.inverse = m->inverse;
+          result->applied_c_m2.emit = m->emit;
+          fern_internal_recognize_idiom(result);
         } else {
           result->type = fern_FunctionType_applied_m2;
           result->applied_m2.f = f_m_g[0];
           result->applied_m2.m = f_m_g[1];
           result->applied_m2.g = f_m_g[2];
         }
+        fern_internal_compile_function(result);
         Stack_push(&s, fern_pack_function(result));
       }
-      break;
+      DISPATCH();
 
     // APPLICATION WITH NOTHING
-    case 18:
+    OP(18)
       {
         fern_Box * f_x = Stack_pop(&s, 2);
         fern_Box result = f_x[1];
         if(!fern_internal_match(f_x[1], fern_nothing())) {
-          result = fern_evoke(f_x[0], fern_Evokation_monad, f_x[1], fern_nothing());
+          result = CallCache_evoke(CALL_CACHE, f_x[0], fern_Evokation_monad, f_x[1], fern_nothing());
         }
         Stack_push(&s, result);
       }
-      break;
-    case 19:
+      DISPATCH();
+    OP(19)
       {
         fern_Box * w_f_x = Stack_pop(&s, 3);
         fern_Box result = w_f_x[2];
         if(!fern_internal_match(w_f_x[2], fern_nothing())) {
           if(!fern_internal_match(w_f_x[0], fern_nothing())) {
-            result = fern_evoke(w_f_x[1], fern_Evokation_dyad, w_f_x[2], w_f_x[0]);
+            result = CallCache_evoke(CALL_CACHE, w_f_x[1], fern_Evokation_dyad, w_f_x[2], w_f_x[0]);
           } else {
-            result = fern_evoke(w_f_x[1], fern_Evokation_monad, w_f_x[2], fern_nothing());
+            result = CallCache_evoke(CALL_CACHE, w_f_x[1], fern_Evokation_monad, w_f_x[2], fern_nothing());
           }
         }        
         Stack_push(&s, result);
       }
-      break;
-    case 23:
+      DISPATCH();
+    OP(23)
       {
         fern_Box * f_g_h = Stack_pop(&s, 3);
         fern_Function result = fern_allocate_function();
@@ -736,15 +1683,16 @@ fern_Box run_bc(uint32_t * bc, uint32_t pos, struct Env * e) {
           result->train3.g = f_g_h[1];
           result->train3.h = f_g_h[2];
         }
+        fern_internal_compile_function(result);
         Stack_push(&s, fern_pack_function(result));
       }
-      break;
-    case 22:
+      DISPATCH();
+    OP(22)
       fern_assert_fatal_error(!fern_internal_match(Stack_peek(&s), fern_nothing()), "Left argument required");
-      break;
+      DISPATCH();
 
     // VARIABLES
-    case 32:
+    OP(32)
       op_a = NEXT;
       op_b = NEXT;
       { struct Env * voe = e;
@@ -754,8 +1702,8 @@ fern_Box run_bc(uint32_t * bc, uint32_t pos, struct Env * e) {
       {
         Stack_push(&s, Var_get(v, fern_COMMERCIAL_AT()));
       }
-      break;
-    case 34:
+      DISPATCH();
+    OP(34)
       op_a = NEXT;
       op_b = NEXT;
       { struct Env * voe = e;
@@ -765,8 +1713,8 @@ fern_Box run_bc(uint32_t * bc, uint32_t pos, struct Env * e) {
       {
         Stack_push(&s, Var_get_c(v, fern_COMMERCIAL_AT()));
       }
-      break;
-    case 33:
+      DISPATCH();
+    OP(33)
       op_a = NEXT;
       op_b = NEXT;
       { struct Env * voe = e;
@@ -776,10 +1724,10 @@ fern_Box run_bc(uint32_t * bc, uint32_t pos, struct Env * e) {
       {
         Stack_push(&s, fern_pack_namespace((fern_Namespace)v));
       }
-      break;
+      DISPATCH();
 
     // HEADERS
-    case 42:
+    OP(42)
       {
         fern_Box predicate = *Stack_pop(&s, 1);
         if(fern_internal_match(predicate, fern_DIGIT_ZERO())) {
@@ -789,21 +1737,21 @@ fern_Box run_bc(uint32_t * bc, uint32_t pos, struct Env * e) {
         }
       }
       break;
-    case 43:
+    OP(43)
       {
         struct Matcher * matcher = Matcher_allocate();
         Matcher_init(matcher, *Stack_pop(&s, 1));
         Stack_push(&s, fern_pack_namespace((fern_Namespace)matcher));
       }
-      break;
-    case 44:
+      DISPATCH();
+    OP(44)
       {
         Stack_push(&s, fern_pack_namespace((fern_Namespace)&vnot));
       }
-      break;
+      DISPATCH();
 
     // ASSIGNMENT
-    case 47:
+    OP(47)
       {
         fern_Box * r_v = Stack_pop(&s, 2);
         union Object * object = (union Object *)fern_unpack_namespace(r_v[0]);
@@ -813,68 +1761,85 @@ fern_Box run_bc(uint32_t * bc, uint32_t pos, struct Env * e) {
         }
       }
       break;
-    case 48:
+    OP(48)
       {
         fern_Box * r_v = Stack_pop(&s, 2);
         union Object * object = (union Object *)fern_unpack_namespace(r_v[0]);
         fern_Box result = Object_set_n(object, r_v[1]);
         Stack_push(&s, result);
       }
-      break;
-    case 49:
+      DISPATCH();
+    OP(49)
       {
         fern_Box * r_v = Stack_pop(&s, 2);
         union Object * object = (union Object *)fern_unpack_namespace(r_v[0]);
         fern_Box result = Object_set_u(object, r_v[1]);
         Stack_push(&s, result);
       }
-      break;
-    case 50:
+      DISPATCH();
+    OP(50)
       {
         fern_Box * r_f_x = Stack_pop(&s, 3);
         union Object * object = (union Object *)fern_unpack_namespace(r_f_x[0]);
-        fern_Box result = Object_get(object, fern_COMMERCIAL_AT());
-        result = fern_evoke(r_f_x[1], fern_Evokation_dyad, result, r_f_x[2]);
-        result = Object_set_u(object, result);
-        Stack_push(&s, result);
+        Stack_push(&s, modify(object, r_f_x[1], fern_Evokation_dyad, r_f_x[2], bc[pos] == 6));
       }
-      break;
-    case 51:
+      DISPATCH();
+    OP(51)
       {
         fern_Box * r_f = Stack_pop(&s, 2);
         union Object * object = (union Object *)fern_unpack_namespace(r_f[0]);
-        fern_Box result = Object_get(object, fern_COMMERCIAL_AT());
-        result = fern_evoke(r_f[1], fern_Evokation_monad, result, fern_nothing());
-        result = Object_set_u(object, result);
-        Stack_push(&s, result);
+        Stack_push(&s, modify(object, r_f[1], fern_Evokation_monad, fern_nothing(), bc[pos] == 6));
       }
-      break;
+      DISPATCH();
 
     // NAMESPACES
-    case 64:
+    OP(64)
       op_a = NEXT;
       {
         struct NS * ns = (struct NS *)fern_unpack_namespace(*Stack_pop(&s, 1));
         Stack_push(&s, NS_read(ns, e, op_a));
       }
-      break;
-    case 66:
+      DISPATCH();
+    OP(66)
       op_a = NEXT;
       {
         struct Alias * alias = Alias_allocate();
         Alias_init(alias, e, op_a, (union Object *)fern_unpack_namespace(*Stack_pop(&s, 1)));
         Stack_push(&s, fern_pack_namespace((fern_Namespace)alias));
       }
-      break;
+      DISPATCH();
 
-    default:
+    default: OP_LABEL(unknown)
       fern_fatal_error("unknown opcode");
     }
   }
 
+  #undef RETHREAD
+  #undef DISPATCH
+  #undef OP_LABEL
+  #undef OP
+  #undef ENTER_TAIL_CALL
+  #undef TAIL_CALL
+  #undef CALL_CACHE
   #undef NEXT
 
+  Stack_tini(&s);
   return s.rslt;
 }
 
 // PROGRAM ------------------------------------------------------------------------------------------------------------
+// done once when a program is loaded, before any of its bodies runs
+void Program_prepare(struct Program * program) {
+  for(uint32_t i = 0; i < program->num_bodies; i++) {
+    program->bodies[i].max_stack = max_stack(program->bc, program->bodies[i].start, program->num_bc);
+  }
+#if BQN_THREADED
+  if(op_handlers == NULL) {
+    run(NULL, 0, NULL, NULL);
+  }
+  program->threaded = calloc(program->num_bc, sizeof(*program->threaded));
+  for(uint32_t pos = 0; pos < program->num_bc; pos += op_length(program->bc[pos])) {
+    program->threaded[pos] = op_handlers[program->bc[pos] < OP_COUNT ? program->bc[pos] : OP_COUNT - 1];
+  }
+#endif
+}
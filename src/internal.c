@@ -2,16 +2,9 @@
 
 static fern_ExStack * current_exstack;
 
-bool fern_ExStack_begin(fern_ExStack * exstack) {
-  fern_ExStack * previous_exstack = current_exstack;
+void fern_ExStack_begin(fern_ExStack * exstack) {
   exstack->previous = current_exstack;
   current_exstack = exstack;
-  if(setjmp(exstack->buf) == 0) {
-    return true;
-  } else {
-    current_exstack = previous_exstack;
-    return false;
-  }
 }
 
 void fern_ExStack_end(fern_ExStack * exstack) {
@@ -20,9 +13,11 @@ void fern_ExStack_end(fern_ExStack * exstack) {
 }
 
 void fern_internal_throw(fern_Box message) {
-  fern_assert_fatal_error(current_exstack == NULL, "%a", message);
-  current_exstack->message = message;
-  longjmp(current_exstack->buf, 1);
+  fern_assert_fatal_error(current_exstack != NULL, "%a", message);
+  fern_ExStack * exstack = current_exstack;
+  current_exstack = exstack->previous;
+  exstack->message = message;
+  longjmp(exstack->buf, 1);
 }
 
 bool fern_internal_match_shape(fern_Array a1, fern_Array a2) {
@@ -32,7 +27,7 @@ bool fern_internal_match_shape(fern_Array a1, fern_Array a2) {
     return false;
   }
   for(uint32_t i = 0; i < fern_array_rank(a1r); i++) {
-    if(fern_array_axis_length(a1r, i) == fern_array_axis_length(a2r, i)) {
+    if(fern_array_axis_length(a1r, i) != fern_array_axis_length(a2r, i)) {
       return false;
     }
   }
@@ -41,6 +36,13 @@ bool fern_internal_match_shape(fern_Array a1, fern_Array a2) {
 
 bool fern_internal_match_full(fern_Box x, fern_Box w) {
   switch(fern_tag(x)) {
+  case fern_Tag_number:
+    return x.number == w.number;
+  case fern_Tag_character:
+  case fern_Tag_symbol:
+  case fern_Tag_namespace:
+  case fern_Tag_stream:
+    return false;
   case fern_Tag_array:
     {
       fern_Array a1 = fern_unpack_array(x);
@@ -51,7 +53,7 @@ bool fern_internal_match_full(fern_Box x, fern_Box w) {
         return false;
       }
       for(uint32_t i = 0; i < fern_array_rank(a1r); i++) {
-        if(fern_array_axis_length(a1r, i) == fern_array_axis_length(a2r, i)) {
+        if(fern_array_axis_length(a1r, i) != fern_array_axis_length(a2r, i)) {
           return false;
         }
       }
@@ -160,3 +162,2438 @@ fern_Box fern_internal_tofill(fern_Box x) {
   }
 }
 
+void fern_internal_expand_fill(fern_ArrayReader x, fern_Data result) {
+  uint32_t n = fern_array_num_cells(x);
+  fern_Box * cells = fern_init_data(result, fern_Format_box, n);
+  for(uint32_t i = 0; i < n; i++) {
+    cells[i] = fern_array_get_cell(x, i);
+  }
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// the smallest byte addressable format holding naturals up to max, falling back to boxed numbers
+fern_Format fern_internal_natural_format(uint64_t max) {
+  if(max <= UINT8_MAX) {
+    return fern_Format_natural_8_bit;
+  }
+  if(max <= UINT16_MAX) {
+    return fern_Format_natural_16_bit;
+  }
+  if(max <= UINT32_MAX) {
+    return fern_Format_natural_32_bit;
+  }
+  return fern_Format_box;
+}
+
+// scan -------------------------------------------------------------------------------------------------------------------------------------------------------
+// natural_1_bit data is little endian bit order, assembled per byte so the compiler can merge it into one load
+static inline uint64_t _load_bits(const uint8_t * bits, uint32_t num_bytes) {
+  uint64_t word = 0;
+  for(uint32_t i = 0; i < num_bytes; i++) {
+    word |= (uint64_t)bits[i] << (i * 8);
+  }
+  return word;
+}
+
+static inline void _store_bits(uint8_t * bits, uint32_t num_bytes, uint64_t word) {
+  for(uint32_t i = 0; i < num_bytes; i++) {
+    bits[i] = word >> (i * 8);
+  }
+}
+
+static inline uint64_t _prefix_or(uint64_t w) {
+  w |= w << 1;
+  w |= w << 2;
+  w |= w << 4;
+  w |= w << 8;
+  w |= w << 16;
+  w |= w << 32;
+  return w;
+}
+
+static inline uint64_t _prefix_xor(uint64_t w) {
+  w ^= w << 1;
+  w ^= w << 2;
+  w ^= w << 4;
+  w ^= w << 8;
+  w ^= w << 16;
+  w ^= w << 32;
+  return w;
+}
+
+static inline bool _get_bit(const uint8_t * bits, uint32_t index) {
+  return (bits[index >> 3] >> (index & 7)) & 1;
+}
+
+static inline void _set_bit(uint8_t * bits, uint32_t index, bool value) {
+  bits[index >> 3] = (bits[index >> 3] & ~(1 << (index & 7))) | (value << (index & 7));
+}
+
+static inline double _scalar_op(fern_ScalarOp op, double w, double x) {
+  switch(op) {
+  case fern_ScalarOp_add:       return w + x;
+  case fern_ScalarOp_multiply:  return w * x;
+  case fern_ScalarOp_max:       return fmax(w, x);
+  case fern_ScalarOp_min:       return fmin(w, x);
+  case fern_ScalarOp_or:        return w + x - w * x;
+  case fern_ScalarOp_and:       return w * x;
+  case fern_ScalarOp_not_equal: return w != x;
+  case fern_ScalarOp_subtract:  return w - x;
+  case fern_ScalarOp_divide:    return w / x;
+  case fern_ScalarOp_equal:     return w == x;
+  default:                      fern_fatal_error("invalid scalar op");
+  }
+}
+
+static uint64_t _natural_max(fern_DataReader x) {
+  uint64_t max = 0;
+  switch(x.format) {
+  case fern_Format_natural_1_bit:
+    for(uint32_t i = 0; i < (x.size + 7) >> 3 && max == 0; i++) {
+      max = x.natural_1_bit[i] & (i == x.size >> 3 ? (1 << (x.size & 7)) - 1 : 0xff) ? 1 : 0;
+    }
+    break;
+  #define _MAX(T) for(uint32_t i = 0; i < x.size; i++) { max = x.T[i] > max ? x.T[i] : max; } break;
+  case fern_Format_natural_8_bit:  _MAX(natural_8_bit)
+  case fern_Format_natural_16_bit: _MAX(natural_16_bit)
+  case fern_Format_natural_32_bit: _MAX(natural_32_bit)
+  #undef _MAX
+  default:
+    fern_fatal_error("invalid format");
+  }
+  return max;
+}
+
+static uint64_t _natural_sum(fern_DataReader x) {
+  uint64_t sum = 0;
+  switch(x.format) {
+  case fern_Format_natural_1_bit:
+    for(uint32_t i = 0; i < x.size >> 3; i++) {
+      sum += __builtin_popcount(x.natural_1_bit[i]);
+    }
+    if(x.size & 7) {
+      sum += __builtin_popcount(x.natural_1_bit[x.size >> 3] & ((1 << (x.size & 7)) - 1));
+    }
+    break;
+  #define _SUM(T) for(uint32_t i = 0; i < x.size; i++) { sum += x.T[i]; } break;
+  case fern_Format_natural_8_bit:  _SUM(natural_8_bit)
+  case fern_Format_natural_16_bit: _SUM(natural_16_bit)
+  case fern_Format_natural_32_bit: _SUM(natural_32_bit)
+  #undef _SUM
+  default:
+    fern_fatal_error("invalid format");
+  }
+  return sum;
+}
+
+// or, and, xor scans of booleans a whole word at a time, carrying the last bit of the previous word
+static void _scan_bits(fern_ScalarOp op, const uint8_t * x, uint32_t size, uint8_t * r) {
+  uint32_t num_bytes = (size + 7) >> 3;
+  uint64_t carry = op == fern_ScalarOp_and ? 1 : 0;
+  for(uint32_t i = 0; i < num_bytes; i += 8) {
+    uint32_t n = num_bytes - i < 8 ? num_bytes - i : 8;
+    uint64_t w = _load_bits(x + i, n);
+    switch(op) {
+    case fern_ScalarOp_or:  w = carry ? ~0ull : _prefix_or(w);     break;
+    case fern_ScalarOp_and: w = carry ? ~_prefix_or(~w) : 0;       break;
+    default:                w = _prefix_xor(w) ^ (carry ? ~0ull : 0); break;
+    }
+    carry = (w >> (n * 8 - 1)) & 1;
+    _store_bits(r + i, n, w);
+  }
+}
+
+// rows of booleans where each row is a whole number of bytes
+static void _scan_bit_rows(fern_ScalarOp op, const uint8_t * x, uint32_t num_bytes, uint32_t row_bytes, uint8_t * r) {
+  memcpy(r, x, row_bytes);
+  for(uint32_t i = row_bytes; i < num_bytes; i++) {
+    switch(op) {
+    case fern_ScalarOp_or:  r[i] = r[i - row_bytes] | x[i]; break;
+    case fern_ScalarOp_and: r[i] = r[i - row_bytes] & x[i]; break;
+    default:                r[i] = r[i - row_bytes] ^ x[i]; break;
+    }
+  }
+}
+
+// naturals to naturals, R is the result type. each row of `stride` cells only depends on the previous row so the inner loop vectorizes
+#define _SCAN_NATURAL(R, T, OP) \
+  { \
+    R * r = (R *)result_cells; \
+    for(uint32_t i = 0; i < stride && i < x.size; i++) { \
+      r[i] = x.T[i]; \
+    } \
+    for(uint32_t i = stride; i < x.size; i++) { \
+      R a = r[i - stride]; \
+      R b = x.T[i]; \
+      r[i] = OP; \
+    } \
+  }
+
+#define _SCAN_NATURAL_OPS(R, T) \
+  switch(op) { \
+  case fern_ScalarOp_add:       _SCAN_NATURAL(R, T, a + b)           break; \
+  case fern_ScalarOp_max:       _SCAN_NATURAL(R, T, a > b ? a : b)   break; \
+  case fern_ScalarOp_min:       _SCAN_NATURAL(R, T, a < b ? a : b)   break; \
+  case fern_ScalarOp_not_equal: _SCAN_NATURAL(R, T, a != b)          break; \
+  default:                      fern_fatal_error("invalid scalar op"); \
+  }
+
+#define _SCAN_NATURAL_RESULT(T) \
+  switch(result_format) { \
+  case fern_Format_natural_8_bit:  _SCAN_NATURAL_OPS(uint8_t, T)  break; \
+  case fern_Format_natural_16_bit: _SCAN_NATURAL_OPS(uint16_t, T) break; \
+  case fern_Format_natural_32_bit: _SCAN_NATURAL_OPS(uint32_t, T) break; \
+  default:                         fern_fatal_error("invalid format"); \
+  }
+
+// anything numeric to boxed numbers
+#define _SCAN_NUMBER(GET) \
+  { \
+    for(uint32_t i = 0; i < stride && i < x.size; i++) { \
+      r[i].number = seed ? _scalar_op(op, seed[i].number, GET) : GET; \
+    } \
+    for(uint32_t i = stride; i < x.size; i++) { \
+      r[i].number = _scalar_op(op, r[i - stride].number, GET); \
+    } \
+  }
+
+bool fern_internal_scan(fern_ScalarOp op, fern_DataReader x, uint32_t stride, const fern_Box * seed, fern_Data result) {
+  if(op == fern_ScalarOp_none || op > fern_ScalarOp_not_equal || stride == 0) {
+    return false;
+  }
+
+  bool numeric_seed = true;
+  for(uint32_t i = 0; seed && i < stride; i++) {
+    numeric_seed = numeric_seed && fern_is_number(seed[i]);
+  }
+  if(!numeric_seed) {
+    return false;
+  }
+
+  if(x.format == fern_Format_character || x.format == fern_Format_symbol) {
+    return false;
+  }
+  if(x.format == fern_Format_box) {
+    for(uint32_t i = 0; i < x.size; i++) {
+      if(!fern_is_number(x.box[i])) {
+        return false;
+      }
+    }
+  }
+
+  // on booleans ∨ and ∧ are ⌈ and ⌊, and so is × with ⌊
+  bool boolean = x.format != fern_Format_box && (x.format == fern_Format_natural_1_bit || _natural_max(x) <= 1);
+  if(boolean && !seed) {
+    switch(op) {
+    case fern_ScalarOp_or:       op = fern_ScalarOp_max; break;
+    case fern_ScalarOp_and:
+    case fern_ScalarOp_multiply: op = fern_ScalarOp_min; break;
+    default:                     break;
+    }
+  }
+
+  if(x.format == fern_Format_natural_1_bit && !seed && op != fern_ScalarOp_add) {
+    fern_ScalarOp bit_op = op == fern_ScalarOp_max ? fern_ScalarOp_or
+                         : op == fern_ScalarOp_min ? fern_ScalarOp_and
+                         :                           fern_ScalarOp_not_equal;
+    uint8_t * r = fern_init_data(result, fern_Format_natural_1_bit, x.size);
+    if(stride == 1) {
+      _scan_bits(bit_op, x.natural_1_bit, x.size, r);
+    } else if((stride & 7) == 0) {
+      _scan_bit_rows(bit_op, x.natural_1_bit, (x.size + 7) >> 3, stride >> 3, r);
+    } else {
+      for(uint32_t i = 0; i < x.size; i++) {
+        bool b = _get_bit(x.natural_1_bit, i);
+        if(i >= stride) {
+          bool a = _get_bit(r, i - stride);
+          b = bit_op == fern_ScalarOp_or ? a | b : bit_op == fern_ScalarOp_and ? a & b : a ^ b;
+        }
+        _set_bit(r, i, b);
+      }
+    }
+    return true;
+  }
+
+  if(x.format == fern_Format_natural_1_bit && !seed) {
+    // + on booleans counts, the total is the largest count
+    fern_Format result_format = fern_internal_natural_format(_natural_sum(x));
+    if(result_format != fern_Format_box) {
+      void * result_cells = fern_init_data(result, result_format, x.size);
+      #define _COUNT(R) \
+        { \
+          R * r = result_cells; \
+          for(uint32_t i = 0; i < x.size; i++) { \
+            r[i] = (i >= stride ? r[i - stride] : 0) + _get_bit(x.natural_1_bit, i); \
+          } \
+        }
+      switch(result_format) {
+      case fern_Format_natural_8_bit:  _COUNT(uint8_t)  break;
+      case fern_Format_natural_16_bit: _COUNT(uint16_t) break;
+      default:                         _COUNT(uint32_t) break;
+      }
+      #undef _COUNT
+      return true;
+    }
+  }
+
+  if(x.format != fern_Format_natural_1_bit && x.format != fern_Format_box && !seed && op != fern_ScalarOp_multiply &&
+     op != fern_ScalarOp_or && op != fern_ScalarOp_and) {
+    // ⌈ ⌊ ≠ stay within the format of 𝕩, + is bounded by the sum of all of 𝕩
+    fern_Format result_format = op == fern_ScalarOp_add ? fern_internal_natural_format(_natural_sum(x)) : x.format;
+    if(result_format != fern_Format_box) {
+      void * result_cells = fern_init_data(result, result_format, x.size);
+      switch(x.format) {
+      case fern_Format_natural_8_bit:  _SCAN_NATURAL_RESULT(natural_8_bit)  break;
+      case fern_Format_natural_16_bit: _SCAN_NATURAL_RESULT(natural_16_bit) break;
+      default:                         _SCAN_NATURAL_RESULT(natural_32_bit) break;
+      }
+      return true;
+    }
+  }
+
+  fern_Box * r = fern_init_data(result, fern_Format_box, x.size);
+  switch(x.format) {
+  case fern_Format_natural_1_bit:  _SCAN_NUMBER(_get_bit(x.natural_1_bit, i)) break;
+  case fern_Format_natural_8_bit:  _SCAN_NUMBER(x.natural_8_bit[i])           break;
+  case fern_Format_natural_16_bit: _SCAN_NUMBER(x.natural_16_bit[i])          break;
+  case fern_Format_natural_32_bit: _SCAN_NUMBER(x.natural_32_bit[i])          break;
+  default:                         _SCAN_NUMBER(x.box[i].number)              break;
+  }
+  return true;
+}
+
+#undef _SCAN_NATURAL
+#undef _SCAN_NATURAL_OPS
+#undef _SCAN_NATURAL_RESULT
+#undef _SCAN_NUMBER
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void fern_internal_copy_cells(void * dst, uint32_t dst_index, fern_DataReader src, uint32_t src_index, uint32_t count) {
+  if(count == 0) {
+    return;
+  }
+  if(src.format == fern_Format_natural_1_bit) {
+    uint8_t * d = dst;
+    uint32_t i = 0;
+    if(((dst_index | src_index) & 7) == 0) {
+      memmove(d + (dst_index >> 3), src.natural_1_bit + (src_index >> 3), count >> 3);
+      i = count & ~7;
+    }
+    for(; i < count; i++) {
+      _set_bit(d, dst_index + i, _get_bit(src.natural_1_bit, src_index + i));
+    }
+    return;
+  }
+  uint32_t cell_size = fern_internal_format_bit_size(src.format) >> 3;
+  memmove((uint8_t *)dst + (size_t)dst_index * cell_size, (const uint8_t *)src.pointer + (size_t)src_index * cell_size, (size_t)count * cell_size);
+}
+
+// compare ----------------------------------------------------------------------------------------------------------------------------------------------------
+static inline int _type_order(fern_Box b) {
+  switch(fern_tag(b)) {
+  case fern_Tag_number:    return 0;
+  case fern_Tag_character: return 1;
+  case fern_Tag_symbol:    return 2;
+  case fern_Tag_array:     return 3;
+  default:                 fern_fatal_error("Cannot compare operations or namespaces");
+  }
+}
+
+int fern_internal_compare(fern_Box w, fern_Box x) {
+  int tw = _type_order(w);
+  int tx = _type_order(x);
+  if(tw != tx) {
+    return tw < tx ? -1 : 1;
+  }
+  switch(fern_tag(w)) {
+  case fern_Tag_number:
+    return w.number < x.number ? -1 : w.number > x.number;
+  case fern_Tag_character:
+  case fern_Tag_symbol:
+    return fern_payload(w) < fern_payload(x) ? -1 : fern_payload(w) > fern_payload(x);
+  default:
+    {
+      fern_ArrayReader war = fern_read_array(fern_unpack_array(w));
+      fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+      uint32_t wl = fern_array_num_cells(war);
+      uint32_t xl = fern_array_num_cells(xar);
+      for(uint32_t i = 0; i < wl && i < xl; i++) {
+        int c = fern_internal_compare(fern_array_get_cell(war, i), fern_array_get_cell(xar, i));
+        if(c != 0) {
+          return c;
+        }
+      }
+      if(wl != xl) {
+        return wl < xl ? -1 : 1;
+      }
+      uint32_t wr = fern_array_rank(war);
+      uint32_t xr = fern_array_rank(xar);
+      return wr < xr ? -1 : wr > xr;
+    }
+  }
+}
+
+// sort -------------------------------------------------------------------------------------------------------------------------------------------------------
+// pattern-defeating quicksort: median of three pivots, insertion sort for small ranges, a bounded insertion sort when a partition
+// did not move anything (already sorted runs) and heapsort once the recursion gets too deep. LESS may read `context`
+#define _PDQSORT(NAME, T, LESS) \
+  static void NAME##_insertion(T * a, uint32_t n, const void * context) { \
+    for(uint32_t i = 1; i < n; i++) { \
+      T v = a[i]; \
+      uint32_t j = i; \
+      for(; j > 0 && LESS(v, a[j - 1]); j--) { \
+        a[j] = a[j - 1]; \
+      } \
+      a[j] = v; \
+    } \
+  } \
+  static bool NAME##_partial_insertion(T * a, uint32_t n, const void * context) { \
+    uint32_t moves = 0; \
+    for(uint32_t i = 1; i < n; i++) { \
+      T v = a[i]; \
+      uint32_t j = i; \
+      for(; j > 0 && LESS(v, a[j - 1]); j--) { \
+        a[j] = a[j - 1]; \
+      } \
+      a[j] = v; \
+      moves += i - j; \
+      if(moves > 8) { \
+        return false; \
+      } \
+    } \
+    return true; \
+  } \
+  static void NAME##_sift(T * a, uint32_t root, uint32_t n, const void * context) { \
+    T v = a[root]; \
+    for(uint32_t child = 2 * root + 1; child < n; child = 2 * root + 1) { \
+      if(child + 1 < n && LESS(a[child], a[child + 1])) { \
+        child++; \
+      } \
+      if(!LESS(v, a[child])) { \
+        break; \
+      } \
+      a[root] = a[child]; \
+      root = child; \
+    } \
+    a[root] = v; \
+  } \
+  static void NAME##_heap(T * a, uint32_t n, const void * context) { \
+    for(uint32_t i = n / 2; i-- > 0;) { \
+      NAME##_sift(a, i, n, context); \
+    } \
+    for(uint32_t i = n; i-- > 1;) { \
+      T t = a[0]; a[0] = a[i]; a[i] = t; \
+      NAME##_sift(a, 0, i, context); \
+    } \
+  } \
+  static void NAME(T * a, uint32_t n, uint32_t depth, const void * context) { \
+    T t; \
+    while(n > 24) { \
+      if(depth-- == 0) { \
+        NAME##_heap(a, n, context); \
+        return; \
+      } \
+      uint32_t m = n / 2; \
+      if(LESS(a[m], a[0]))     { t = a[m]; a[m] = a[0]; a[0] = t; } \
+      if(LESS(a[n - 1], a[m])) { t = a[m]; a[m] = a[n - 1]; a[n - 1] = t; } \
+      if(LESS(a[m], a[0]))     { t = a[m]; a[m] = a[0]; a[0] = t; } \
+      t = a[m]; a[m] = a[0]; a[0] = t; \
+      T pivot = a[0]; \
+      uint32_t i = 0, j = n; \
+      bool swapped = false; \
+      for(;;) { \
+        do { i++; } while(i < n && LESS(a[i], pivot)); \
+        do { j--; } while(LESS(pivot, a[j])); \
+        if(i >= j) { \
+          break; \
+        } \
+        t = a[i]; a[i] = a[j]; a[j] = t; \
+        swapped = true; \
+      } \
+      a[0] = a[j]; \
+      a[j] = pivot; \
+      if(!swapped && NAME##_partial_insertion(a, j, context) && NAME##_partial_insertion(a + j + 1, n - j - 1, context)) { \
+        return; \
+      } \
+      if(j < n - j - 1) { \
+        NAME(a, j, depth, context); \
+        a += j + 1; \
+        n -= j + 1; \
+      } else { \
+        NAME(a + j + 1, n - j - 1, depth, context); \
+        n = j; \
+      } \
+    } \
+    NAME##_insertion(a, n, context); \
+  }
+
+static inline uint32_t _sort_depth(uint32_t n) {
+  return 2 * (32 - __builtin_clz(n | 1));
+}
+
+typedef struct {
+  double   key;
+  uint32_t index;
+} _NumberIndex;
+
+typedef struct {
+  const fern_Box * cells;
+  fern_ArrayReader array;
+  uint32_t         stride;
+  bool             down;
+} _GradeContext;
+
+static inline int _grade_compare(const _GradeContext * context, uint32_t a, uint32_t b) {
+  int c = 0;
+  if(context->cells) {
+    c = fern_internal_compare(context->cells[a], context->cells[b]);
+  } else {
+    for(uint32_t k = 0; k < context->stride && c == 0; k++) {
+      c = fern_internal_compare(
+          fern_array_get_cell(context->array, a * context->stride + k)
+        , fern_array_get_cell(context->array, b * context->stride + k)
+        );
+    }
+  }
+  c = context->down ? -c : c;
+  return c != 0 ? c : (a < b ? -1 : a > b);
+}
+
+#define _LESS_DOUBLE(a, b)      ((a) < (b))
+#define _LESS_BOX(a, b)         (fern_internal_compare((a), (b)) < 0)
+#define _LESS_NUMBER_UP(a, b)   ((a).key < (b).key || ((a).key == (b).key && (a).index < (b).index))
+#define _LESS_NUMBER_DOWN(a, b) ((a).key > (b).key || ((a).key == (b).key && (a).index < (b).index))
+#define _LESS_GRADE(a, b)       (_grade_compare(context, (a), (b)) < 0)
+
+_PDQSORT(_sort_double, double, _LESS_DOUBLE)
+_PDQSORT(_sort_box, fern_Box, _LESS_BOX)
+_PDQSORT(_grade_number_up, _NumberIndex, _LESS_NUMBER_UP)
+_PDQSORT(_grade_number_down, _NumberIndex, _LESS_NUMBER_DOWN)
+_PDQSORT(_grade_generic, uint32_t, _LESS_GRADE)
+
+#undef _LESS_DOUBLE
+#undef _LESS_BOX
+#undef _LESS_NUMBER_UP
+#undef _LESS_NUMBER_DOWN
+#undef _LESS_GRADE
+#undef _PDQSORT
+
+// keys of the integer formats with the minimum subtracted, returns the range of the keys
+static uint32_t _sort_keys(fern_DataReader x, uint32_t * keys, uint32_t * key_min) {
+  uint32_t min = UINT32_MAX, max = 0;
+  #define _KEYS(T) \
+    for(uint32_t i = 0; i < x.size; i++) { \
+      keys[i] = x.T[i]; \
+      min = keys[i] < min ? keys[i] : min; \
+      max = keys[i] > max ? keys[i] : max; \
+    } \
+    break;
+  switch(x.format) {
+  case fern_Format_natural_8_bit:  _KEYS(natural_8_bit)
+  case fern_Format_natural_16_bit: _KEYS(natural_16_bit)
+  case fern_Format_natural_32_bit: _KEYS(natural_32_bit)
+  case fern_Format_character:      _KEYS(character)
+  case fern_Format_symbol:         _KEYS(symbol)
+  default:                         fern_fatal_error("invalid format");
+  }
+  #undef _KEYS
+  for(uint32_t i = 0; i < x.size; i++) {
+    keys[i] -= min;
+  }
+  *key_min = min;
+  return x.size ? max - min : 0;
+}
+
+// small ranges (every natural_8_bit array, short character ranges) are counted rather than compared
+static inline bool _use_counting(uint32_t range, uint32_t size) {
+  return range < (1u << 16) && range <= 4 * size + 256;
+}
+
+// least significant digit radix sort on bytes of the keys, skipping digits that are the same for every key. when `index` is
+// not NULL it is permuted along with the keys, and the result is stable
+static void _radix(uint32_t * keys, uint32_t * index, uint32_t n, uint32_t range) {
+  uint32_t (*counts)[256] = calloc(4, sizeof(*counts));
+  for(uint32_t i = 0; i < n; i++) {
+    uint32_t k = keys[i];
+    counts[0][k & 0xff]++;
+    counts[1][(k >> 8) & 0xff]++;
+    counts[2][(k >> 16) & 0xff]++;
+    counts[3][k >> 24]++;
+  }
+
+  uint32_t * keys_tmp = malloc(sizeof(uint32_t) * n);
+  uint32_t * index_tmp = index ? malloc(sizeof(uint32_t) * n) : NULL;
+
+  for(uint32_t digit = 0; digit < 4 && (range >> (digit * 8)) != 0; digit++) {
+    uint32_t shift = digit * 8;
+    if(counts[digit][(keys[0] >> shift) & 0xff] == n) {
+      continue;
+    }
+
+    uint32_t offset = 0;
+    for(uint32_t d = 0; d < 256; d++) {
+      uint32_t c = counts[digit][d];
+      counts[digit][d] = offset;
+      offset += c;
+    }
+
+    for(uint32_t i = 0; i < n; i++) {
+      uint32_t o = counts[digit][(keys[i] >> shift) & 0xff]++;
+      keys_tmp[o] = keys[i];
+      if(index) {
+        index_tmp[o] = index[i];
+      }
+    }
+
+    memcpy(keys, keys_tmp, sizeof(uint32_t) * n);
+    if(index) {
+      memcpy(index, index_tmp, sizeof(uint32_t) * n);
+    }
+  }
+
+  free(index_tmp);
+  free(keys_tmp);
+  free(counts);
+}
+
+static bool _all_numbers(fern_DataReader x) {
+  for(uint32_t i = 0; i < x.size; i++) {
+    if(!fern_is_number(x.box[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void fern_internal_sort(fern_DataReader x, bool down, fern_Data result) {
+  uint32_t n = x.size;
+
+  if(x.format == fern_Format_natural_1_bit) {
+    uint32_t ones = _natural_sum(x);
+    uint8_t * r = fern_init_data(result, fern_Format_natural_1_bit, n);
+    memset(r, 0, (n + 7) >> 3);
+    for(uint32_t i = down ? 0 : n - ones; i < (down ? ones : n); i++) {
+      _set_bit(r, i, true);
+    }
+    return;
+  }
+
+  if(x.format == fern_Format_box) {
+    fern_Box * r = fern_init_data(result, fern_Format_box, n);
+    if(_all_numbers(x)) {
+      double * numbers = (double *)r;
+      for(uint32_t i = 0; i < n; i++) {
+        numbers[i] = x.box[i].number;
+      }
+      _sort_double(numbers, n, _sort_depth(n), NULL);
+    } else {
+      memcpy(r, x.box, sizeof(*r) * n);
+      _sort_box(r, n, _sort_depth(n), NULL);
+    }
+    for(uint32_t i = 0; down && i < n / 2; i++) {
+      fern_Box t = r[i]; r[i] = r[n - 1 - i]; r[n - 1 - i] = t;
+    }
+    return;
+  }
+
+  uint32_t * keys = malloc(sizeof(uint32_t) * (n ? n : 1));
+  uint32_t min;
+  uint32_t range = _sort_keys(x, keys, &min);
+
+  if(_use_counting(range, n)) {
+    uint32_t * counts = calloc(range + 1, sizeof(uint32_t));
+    for(uint32_t i = 0; i < n; i++) {
+      counts[keys[i]]++;
+    }
+    uint32_t o = 0;
+    for(uint32_t k = 0; k <= range; k++) {
+      for(uint32_t c = counts[k]; c; c--) {
+        keys[o++] = k;
+      }
+    }
+    free(counts);
+  } else {
+    _radix(keys, NULL, n, range);
+  }
+
+  void * r = fern_init_data(result, x.format, n);
+  #define _WRITE(T) \
+    for(uint32_t i = 0; i < n; i++) { \
+      ((T *)r)[i] = keys[down ? n - 1 - i : i] + min; \
+    } \
+    break;
+  switch(x.format) {
+  case fern_Format_natural_8_bit:  _WRITE(uint8_t)
+  case fern_Format_natural_16_bit: _WRITE(uint16_t)
+  default:                         _WRITE(uint32_t)
+  }
+  #undef _WRITE
+  free(keys);
+}
+
+void fern_internal_grade(fern_DataReader x, bool down, uint32_t * order) {
+  uint32_t n = x.size;
+
+  if(x.format == fern_Format_natural_1_bit) {
+    uint32_t ones = _natural_sum(x);
+    uint32_t o[2] = { down ? ones : 0, down ? 0 : n - ones };
+    for(uint32_t i = 0; i < n; i++) {
+      order[o[_get_bit(x.natural_1_bit, i)]++] = i;
+    }
+    return;
+  }
+
+  if(x.format == fern_Format_box) {
+    if(_all_numbers(x)) {
+      _NumberIndex * pairs = malloc(sizeof(*pairs) * (n ? n : 1));
+      for(uint32_t i = 0; i < n; i++) {
+        pairs[i] = (_NumberIndex) { .key = x.box[i].number, .index = i };
+      }
+      if(down) {
+        _grade_number_down(pairs, n, _sort_depth(n), NULL);
+      } else {
+        _grade_number_up(pairs, n, _sort_depth(n), NULL);
+      }
+      for(uint32_t i = 0; i < n; i++) {
+        order[i] = pairs[i].index;
+      }
+      free(pairs);
+    } else {
+      _GradeContext context = { .cells = x.box, .stride = 1, .down = down };
+      for(uint32_t i = 0; i < n; i++) {
+        order[i] = i;
+      }
+      _grade_generic(order, n, _sort_depth(n), &context);
+    }
+    return;
+  }
+
+  uint32_t * keys = malloc(sizeof(uint32_t) * (n ? n : 1));
+  uint32_t min;
+  uint32_t range = _sort_keys(x, keys, &min);
+  if(down) {
+    for(uint32_t i = 0; i < n; i++) {
+      keys[i] = range - keys[i];
+    }
+  }
+
+  if(_use_counting(range, n)) {
+    uint32_t * offsets = calloc(range + 1, sizeof(uint32_t));
+    for(uint32_t i = 0; i < n; i++) {
+      offsets[keys[i]]++;
+    }
+    uint32_t o = 0;
+    for(uint32_t k = 0; k <= range; k++) {
+      uint32_t c = offsets[k];
+      offsets[k] = o;
+      o += c;
+    }
+    for(uint32_t i = 0; i < n; i++) {
+      order[offsets[keys[i]]++] = i;
+    }
+    free(offsets);
+  } else {
+    for(uint32_t i = 0; i < n; i++) {
+      order[i] = i;
+    }
+    _radix(keys, order, n, range);
+  }
+  free(keys);
+}
+
+void fern_internal_grade_cells(fern_ArrayReader x, uint32_t stride, bool down, uint32_t * order) {
+  uint32_t n = fern_array_axis_length(x, 0);
+  _GradeContext context = { .cells = NULL, .array = x, .stride = stride, .down = down };
+  for(uint32_t i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  _grade_generic(order, n, _sort_depth(n), &context);
+}
+
+void fern_internal_grade_major(fern_ArrayReader x, bool down, fern_Data result) {
+  uint32_t l = fern_array_num_cells(x);
+  uint32_t n = fern_array_axis_length(x, 0);
+  fern_Format format = fern_internal_natural_format(n ? n - 1 : 0);
+
+  uint32_t * order = format == fern_Format_natural_32_bit ? fern_init_data(result, format, n) : malloc(sizeof(uint32_t) * (n ? n : 1));
+  if(n == l && x.cells.size == l) {
+    fern_internal_grade(x.cells, down, order);
+  } else {
+    fern_internal_grade_cells(x, n ? l / n : 0, down, order);
+  }
+  if(format == fern_Format_natural_32_bit) {
+    return;
+  }
+
+  void * r = fern_init_data(result, format, n);
+  #define _NARROW(T) for(uint32_t i = 0; i < n; i++) { ((T *)r)[i] = order[i]; }
+  if(format == fern_Format_natural_8_bit) {
+    _NARROW(uint8_t)
+  } else {
+    _NARROW(uint16_t)
+  }
+  #undef _NARROW
+  free(order);
+}
+
+// search -----------------------------------------------------------------------------------------------------------------------------------------------------
+static inline uint64_t _mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+uint64_t fern_internal_hash(fern_Box x) {
+  if(fern_is_number(x)) {
+    return _mix(x.number == 0 ? 0 : x.bits);
+  }
+  if(!fern_is_array(x)) {
+    return _mix(x.bits);
+  }
+  fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+  uint64_t h = _mix(fern_array_rank(xar));
+  for(uint32_t i = 0; i < fern_array_rank(xar); i++) {
+    h = _mix(h ^ fern_array_axis_length(xar, i));
+  }
+  for(uint32_t i = 0; i < fern_array_num_cells(xar); i++) {
+    h = _mix(h ^ fern_internal_hash(fern_array_get_cell(xar, i)));
+  }
+  return h;
+}
+
+// cells of the natural formats are numbers, so any two of them can be compared as keys. other formats only equal themselves
+static inline int _search_kind(fern_Format format) {
+  switch(format) {
+  case fern_Format_character: return 1;
+  case fern_Format_symbol:    return 2;
+  case fern_Format_box:       return 3;
+  default:                    return 0;
+  }
+}
+
+static inline bool _search_equal(fern_Box a, fern_Box b) {
+  return fern_is_number(a) && fern_is_number(b) ? a.number == b.number : fern_internal_match(a, b);
+}
+
+// lookup tables hold, for each key, the first unused index of w with that key. `next` chains equal keys for ⊒
+static void _search_table(fern_Search search, const uint32_t * w_keys, uint32_t n, uint32_t range, const uint32_t * x_keys, uint32_t m, uint32_t * result) {
+  uint32_t * table = malloc(sizeof(uint32_t) * (range + 1));
+  for(uint32_t k = 0; k <= range; k++) {
+    table[k] = n;
+  }
+  uint32_t * next = search == fern_Search_progressive_index_of ? malloc(sizeof(uint32_t) * (n ? n : 1)) : NULL;
+  for(uint32_t i = n; i-- > 0;) {
+    if(next) {
+      next[i] = table[w_keys[i]];
+    }
+    table[w_keys[i]] = i;
+  }
+  for(uint32_t i = 0; i < m; i++) {
+    uint32_t k = x_keys[i];
+    uint32_t r = k <= range ? table[k] : n;
+    if(next && r != n) {
+      table[k] = next[r];
+    }
+    result[i] = r;
+  }
+  free(next);
+  free(table);
+}
+
+// tiny w fits in a few vector registers, a branch-free scan from the back leaves the first match
+static void _search_linear(fern_Search search, const uint32_t * w_keys, uint32_t n, const uint32_t * x_keys, uint32_t m, uint32_t * result) {
+  if(search == fern_Search_index_of) {
+    for(uint32_t i = 0; i < m; i++) {
+      uint32_t k = x_keys[i];
+      uint32_t r = n;
+      for(uint32_t j = n; j-- > 0;) {
+        r = w_keys[j] == k ? j : r;
+      }
+      result[i] = r;
+    }
+    return;
+  }
+  uint64_t used = 0;
+  for(uint32_t i = 0; i < m; i++) {
+    uint32_t r = n;
+    for(uint32_t j = 0; j < n; j++) {
+      if(w_keys[j] == x_keys[i] && !(used & (1ull << j))) {
+        r = j;
+        used |= 1ull << j;
+        break;
+      }
+    }
+    result[i] = r;
+  }
+}
+
+// open addressing with linear probing, slots hold index + 1 so zero is empty. each slot caches the hash of its cell so cells
+// of w are only compared when the hashes agree
+typedef struct {
+  uint64_t hash;
+  uint32_t index;
+} _HashSlot;
+
+static void _search_hash(fern_Search search, fern_DataReader w, fern_DataReader x, uint32_t * result) {
+  uint32_t n = w.size;
+  uint32_t capacity = 16;
+  while(capacity < 2 * (uint64_t)n) {
+    capacity <<= 1;
+  }
+  uint32_t mask = capacity - 1;
+  _HashSlot * slots = calloc(capacity, sizeof(*slots));
+
+  // for ⊒ equal cells of w are chained from the first one, and `cursor` is the next unused one in each chain
+  uint32_t * next = NULL;
+  uint32_t * cursor = NULL;
+  if(search == fern_Search_progressive_index_of) {
+    next = malloc(sizeof(uint32_t) * (n ? n : 1));
+    cursor = malloc(sizeof(uint32_t) * (n ? n : 1));
+  }
+
+  for(uint32_t i = 0; i < n; i++) {
+    fern_Box cell = fern_data_get_cell(w, i);
+    uint64_t h = fern_internal_hash(cell);
+    if(next) {
+      next[i] = n;
+      cursor[i] = i;
+    }
+    for(uint32_t s = h & mask;; s = (s + 1) & mask) {
+      if(slots[s].index == 0) {
+        slots[s] = (_HashSlot) { .hash = h, .index = i + 1 };
+        break;
+      }
+      uint32_t j = slots[s].index - 1;
+      if(slots[s].hash == h && _search_equal(fern_data_get_cell(w, j), cell)) {
+        if(next) {
+          while(next[j] != n) {
+            j = next[j];
+          }
+          next[j] = i;
+        }
+        break;
+      }
+    }
+  }
+
+  for(uint32_t i = 0; i < x.size; i++) {
+    fern_Box cell = fern_data_get_cell(x, i);
+    uint64_t h = fern_internal_hash(cell);
+    uint32_t r = n;
+    for(uint32_t s = h & mask; slots[s].index != 0; s = (s + 1) & mask) {
+      uint32_t j = slots[s].index - 1;
+      if(slots[s].hash == h && _search_equal(fern_data_get_cell(w, j), cell)) {
+        r = j;
+        if(cursor) {
+          r = cursor[j];
+          cursor[j] = r != n ? next[r] : n;
+        }
+        break;
+      }
+    }
+    result[i] = r;
+  }
+
+  free(cursor);
+  free(next);
+  free(slots);
+}
+
+void fern_internal_search(fern_Search search, fern_DataReader w, fern_DataReader x, uint32_t * result) {
+  uint32_t n = w.size;
+  uint32_t m = x.size;
+
+  int w_kind = _search_kind(w.format);
+  int x_kind = _search_kind(x.format);
+
+  if(w_kind == 3 || x_kind == 3 || x.format == fern_Format_natural_1_bit || w.format == fern_Format_natural_1_bit) {
+    _search_hash(search, w, x, result);
+    return;
+  }
+
+  if(w_kind != x_kind) {
+    for(uint32_t i = 0; i < m; i++) {
+      result[i] = n;
+    }
+    return;
+  }
+
+  // every other format is at most 32 bits a cell, and searching works on the plain keys
+  uint32_t * w_keys = malloc(sizeof(uint32_t) * (n ? n : 1));
+  uint32_t * x_keys = malloc(sizeof(uint32_t) * (m ? m : 1));
+  uint32_t w_min;
+  uint32_t w_range = _sort_keys(w, w_keys, &w_min);
+  for(uint32_t i = 0; i < m; i++) {
+    uint32_t k;
+    switch(x.format) {
+    case fern_Format_natural_8_bit:  k = x.natural_8_bit[i];  break;
+    case fern_Format_natural_16_bit: k = x.natural_16_bit[i]; break;
+    default:                         k = x.natural_32_bit[i]; break;
+    }
+    // keys below the minimum of w wrap around past the range and are never found
+    x_keys[i] = k - w_min;
+  }
+
+  if(n <= 16) {
+    _search_linear(search, w_keys, n, x_keys, m, result);
+  } else if(w_range < (1u << 16) || (w_range <= 2 * (uint64_t)n + m)) {
+    _search_table(search, w_keys, n, w_range, x_keys, m, result);
+  } else {
+    free(w_keys);
+    free(x_keys);
+    _search_hash(search, w, x, result);
+    return;
+  }
+
+  free(w_keys);
+  free(x_keys);
+}
+
+// group ------------------------------------------------------------------------------------------------------------------------------------------------------
+static uint32_t * _grow_counts(uint32_t * counts, uint32_t * capacity, uint64_t needed) {
+  if(needed <= *capacity) {
+    return counts;
+  }
+  uint64_t new_capacity = *capacity;
+  while(new_capacity < needed) {
+    new_capacity *= 2;
+  }
+  fern_assert_fatal_error(new_capacity <= UINT32_MAX, "⊔: group index too large");
+  counts = realloc(counts, sizeof(uint32_t) * new_capacity);
+  memset(counts + *capacity, 0, sizeof(uint32_t) * (new_capacity - *capacity));
+  *capacity = new_capacity;
+  return counts;
+}
+
+// four interleaved tables so consecutive equal indices do not wait on the store of the previous increment
+#define _HISTOGRAM_4(T, SIZE) \
+  { \
+    uint32_t (*tables)[SIZE] = calloc(4, sizeof(*tables)); \
+    uint32_t i = 0; \
+    for(; i + 4 <= n; i += 4) { \
+      tables[0][x.T[i + 0]]++; \
+      tables[1][x.T[i + 1]]++; \
+      tables[2][x.T[i + 2]]++; \
+      tables[3][x.T[i + 3]]++; \
+    } \
+    for(; i < n; i++) { \
+      tables[0][x.T[i]]++; \
+    } \
+    uint32_t last = 0; \
+    for(uint32_t k = 0; k < SIZE; k++) { \
+      tables[0][k] += tables[1][k] + tables[2][k] + tables[3][k]; \
+      last = tables[0][k] ? k + 1 : last; \
+    } \
+    groups = last > groups ? last : groups; \
+    counts = _grow_counts(counts, &capacity, groups); \
+    memcpy(counts, tables[0], sizeof(uint32_t) * (last < capacity ? last : capacity)); \
+    free(tables); \
+  }
+
+uint32_t * fern_internal_group_lengths(fern_ArrayReader xar, uint32_t min_length, uint32_t * num_groups) {
+  fern_DataReader x = xar.cells;
+  uint32_t n = x.size;
+  uint32_t capacity = 16;
+  uint64_t groups = min_length;
+  uint32_t * counts = _grow_counts(calloc(capacity, sizeof(uint32_t)), &capacity, groups);
+
+  switch(x.format) {
+  case fern_Format_natural_1_bit:
+    {
+      uint32_t ones = _natural_sum(x);
+      groups = (ones ? 2 : n ? 1 : 0) > groups ? (ones ? 2 : n ? 1 : 0) : groups;
+      counts[0] = n - ones;
+      counts[1] = ones;
+    }
+    break;
+  case fern_Format_natural_8_bit:
+    _HISTOGRAM_4(natural_8_bit, 256)
+    break;
+  case fern_Format_natural_16_bit:
+    if(n >= (1u << 14)) {
+      _HISTOGRAM_4(natural_16_bit, 65536)
+      break;
+    }
+    // fall through: small inputs would spend more time clearing tables than counting
+  case fern_Format_natural_32_bit:
+  case fern_Format_box:
+    for(uint32_t i = 0; i < n; i++) {
+      int64_t v;
+      switch(x.format) {
+      case fern_Format_natural_16_bit: v = x.natural_16_bit[i];             break;
+      case fern_Format_natural_32_bit: v = x.natural_32_bit[i];             break;
+      default:                         v = fern_force_natural(x.box[i]);    break;
+      }
+      if(v < 0) {
+        continue;
+      }
+      if(v >= capacity) {
+        counts = _grow_counts(counts, &capacity, v + 1);
+      }
+      counts[v]++;
+      groups = v + 1 > groups ? v + 1 : groups;
+    }
+    break;
+  default:
+    fern_fatal_error("GroupLen: 𝕩 must be natural numbers");
+  }
+
+  // cells past the stored ones all read as the fill, which is one more index
+  uint32_t tail = fern_array_num_cells(xar) - n;
+  int64_t v = tail ? fern_force_natural(fern_array_fill(xar)) : -1;
+  if(v >= 0) {
+    counts = _grow_counts(counts, &capacity, v + 1);
+    counts[v] += tail;
+    groups = v + 1 > groups ? v + 1 : groups;
+  }
+
+  *num_groups = groups;
+  return counts;
+}
+
+#undef _HISTOGRAM_4
+
+void fern_internal_group_order(fern_ArrayReader xar, uint32_t * offsets, uint32_t num_groups, uint32_t * order) {
+  fern_DataReader x = xar.cells;
+  uint32_t o = 0;
+  for(uint32_t k = 0; k < num_groups; k++) {
+    uint32_t c = offsets[k];
+    offsets[k] = o;
+    o += c;
+  }
+
+  #define _SCATTER(GET) \
+    for(uint32_t i = 0; i < x.size; i++) { \
+      int64_t v = GET; \
+      if(v >= 0 && v < num_groups) { \
+        order[offsets[v]++] = i; \
+      } \
+    } \
+    break;
+  switch(x.format) {
+  case fern_Format_natural_1_bit:  _SCATTER(_get_bit(x.natural_1_bit, i))
+  case fern_Format_natural_8_bit:  _SCATTER(x.natural_8_bit[i])
+  case fern_Format_natural_16_bit: _SCATTER(x.natural_16_bit[i])
+  case fern_Format_natural_32_bit: _SCATTER(x.natural_32_bit[i])
+  case fern_Format_box:            _SCATTER(fern_force_natural(x.box[i]))
+  default:                         fern_fatal_error("GroupOrd: 𝕩 must be natural numbers");
+  }
+  #undef _SCATTER
+
+  uint32_t n = fern_array_num_cells(xar);
+  int64_t v = x.size < n ? fern_force_natural(fern_array_fill(xar)) : -1;
+  if(v >= 0 && v < num_groups) {
+    for(uint32_t i = x.size; i < n; i++) {
+      order[offsets[v]++] = i;
+    }
+  }
+}
+
+// replicate --------------------------------------------------------------------------------------------------------------------------------------------------
+// the mask word for cells [i, i + 64) with bits past the end cleared
+static inline uint64_t _mask_word(fern_DataReader mask, uint32_t i) {
+  uint32_t n = mask.size - i < 64 ? mask.size - i : 64;
+  uint64_t word = _load_bits(mask.natural_1_bit + (i >> 3), (n + 7) >> 3);
+  return n == 64 ? word : word & ((1ull << n) - 1);
+}
+
+// counts widened to 32 bits in one pass per format, with their total
+static uint32_t * _natural_counts(fern_DataReader w, uint64_t * total) {
+  uint32_t * counts = malloc(sizeof(uint32_t) * (w.size ? w.size : 1));
+  *total = 0;
+  #define _WIDEN(GET) \
+    for(uint32_t i = 0; i < w.size; i++) { \
+      counts[i] = GET; \
+      *total += counts[i]; \
+    } \
+    break;
+  switch(w.format) {
+  case fern_Format_natural_8_bit:  _WIDEN(w.natural_8_bit[i])
+  case fern_Format_natural_16_bit: _WIDEN(w.natural_16_bit[i])
+  case fern_Format_natural_32_bit: _WIDEN(w.natural_32_bit[i])
+  case fern_Format_box:
+    for(uint32_t i = 0; i < w.size; i++) {
+      int64_t k = fern_force_natural(w.box[i]);
+      fern_assert_fatal_error(k >= 0, "/: 𝕨 must consist of natural numbers");
+      counts[i] = k;
+      *total += k;
+    }
+    break;
+  default:
+    fern_fatal_error("/: 𝕨 must consist of natural numbers");
+  }
+  #undef _WIDEN
+  return counts;
+}
+
+// cells are moved as plain integers of their byte width, so characters, symbols and boxes share the natural kernels
+#define _BY_WIDTH(WIDTH, MACRO) \
+  switch(WIDTH) { \
+  case 1:  MACRO(uint8_t)  break; \
+  case 2:  MACRO(uint16_t) break; \
+  case 4:  MACRO(uint32_t) break; \
+  default: MACRO(uint64_t) break; \
+  }
+
+static uint32_t _compress(fern_DataReader mask, fern_DataReader x, uint32_t stride, fern_Data result) {
+  uint32_t n = mask.size;
+  uint32_t count = _natural_sum(mask);
+  void * dst = fern_init_data(result, x.format, count * stride);
+
+  uint32_t o = 0;
+  if(x.format != fern_Format_natural_1_bit && stride == 1) {
+    // one word of the mask at a time: all set is a block copy, none set is skipped, otherwise walk the set bits
+    #define _COMPRESS(T) \
+      { \
+        T * d = dst; \
+        const T * s = (const T *)x.pointer; \
+        for(uint32_t i = 0; i < n; i += 64) { \
+          uint64_t m = _mask_word(mask, i); \
+          if(m == ~0ull) { \
+            memcpy(d + o, s + i, sizeof(T) * 64); \
+            o += 64; \
+            continue; \
+          } \
+          for(; m; m &= m - 1) { \
+            d[o++] = s[i + __builtin_ctzll(m)]; \
+          } \
+        } \
+      }
+    _BY_WIDTH(fern_internal_format_bit_size(x.format) >> 3, _COMPRESS)
+    #undef _COMPRESS
+    return count;
+  }
+
+  for(uint32_t i = 0; i < n; i += 64) {
+    uint64_t m = _mask_word(mask, i);
+    if(m == ~0ull) {
+      fern_internal_copy_cells(dst, o * stride, x, i * stride, 64 * stride);
+      o += 64;
+      continue;
+    }
+    for(; m; m &= m - 1) {
+      fern_internal_copy_cells(dst, o * stride, x, (i + __builtin_ctzll(m)) * stride, stride);
+      o++;
+    }
+  }
+  return count;
+}
+
+uint32_t fern_internal_replicate(fern_DataReader w, fern_DataReader x, uint32_t stride, fern_Data result) {
+  uint32_t n = w.size;
+  if(w.format == fern_Format_natural_1_bit) {
+    return _compress(w, x, stride, result);
+  }
+
+  uint64_t total;
+  uint32_t * counts = _natural_counts(w, &total);
+  fern_assert_fatal_error(total * stride <= UINT32_MAX, "/: result too large");
+  void * dst = fern_init_data(result, x.format, total * stride);
+
+  uint32_t o = 0;
+  if(x.format != fern_Format_natural_1_bit && stride == 1) {
+    #define _EXPAND(T) \
+      { \
+        T * d = dst; \
+        const T * s = (const T *)x.pointer; \
+        for(uint32_t i = 0; i < n; i++) { \
+          T v = s[i]; \
+          for(uint32_t k = counts[i]; k; k--) { \
+            d[o++] = v; \
+          } \
+        } \
+      }
+    _BY_WIDTH(fern_internal_format_bit_size(x.format) >> 3, _EXPAND)
+    #undef _EXPAND
+  } else {
+    for(uint32_t i = 0; i < n; i++) {
+      for(uint32_t k = counts[i]; k; k--) {
+        fern_internal_copy_cells(dst, o * stride, x, i * stride, stride);
+        o++;
+      }
+    }
+  }
+  free(counts);
+  return total;
+}
+
+void fern_internal_indices(fern_DataReader x, fern_Data result) {
+  uint32_t n = x.size;
+  fern_Format format = fern_internal_natural_format(n ? n - 1 : 0);
+
+  if(x.format == fern_Format_natural_1_bit) {
+    void * dst = fern_init_data(result, format, _natural_sum(x));
+    uint32_t o = 0;
+    #define _SET_BITS(T) \
+      for(uint32_t i = 0; i < n; i += 64) { \
+        for(uint64_t m = _mask_word(x, i); m; m &= m - 1) { \
+          ((T *)dst)[o++] = i + __builtin_ctzll(m); \
+        } \
+      }
+    _BY_WIDTH(fern_internal_format_bit_size(format) >> 3, _SET_BITS)
+    #undef _SET_BITS
+    return;
+  }
+
+  uint64_t total;
+  uint32_t * counts = _natural_counts(x, &total);
+  fern_assert_fatal_error(total <= UINT32_MAX, "/: result too large");
+  void * dst = fern_init_data(result, format, total);
+  uint32_t o = 0;
+  #define _REPEAT_INDEX(T) \
+    for(uint32_t i = 0; i < n; i++) { \
+      for(uint32_t k = counts[i]; k; k--) { \
+        ((T *)dst)[o++] = i; \
+      } \
+    }
+  _BY_WIDTH(fern_internal_format_bit_size(format) >> 3, _REPEAT_INDEX)
+  #undef _REPEAT_INDEX
+  free(counts);
+}
+
+// structural ------------------------------------------------------------------------------------------------------------------------------------------------
+// reverse the bit order of a word
+static inline uint64_t _reverse_bits(uint64_t w) {
+  w = ((w >> 1) & 0x5555555555555555ull) | ((w & 0x5555555555555555ull) << 1);
+  w = ((w >> 2) & 0x3333333333333333ull) | ((w & 0x3333333333333333ull) << 2);
+  w = ((w >> 4) & 0x0f0f0f0f0f0f0f0full) | ((w & 0x0f0f0f0f0f0f0f0full) << 4);
+  return __builtin_bswap64(w);
+}
+
+// the 64 bits [start, start + 64) of a list of `size` bits, positions outside of the list read as zero
+static inline uint64_t _bits_at(const uint8_t * bits, uint32_t size, int64_t start) {
+  if(start < 0) {
+    return start <= -64 ? 0 : _bits_at(bits, size, 0) << -start;
+  }
+  if(start >= size) {
+    return 0;
+  }
+  uint32_t byte = start >> 3;
+  uint32_t shift = start & 7;
+  uint32_t num_bytes = ((size + 7) >> 3) - byte;
+  uint64_t word = _load_bits(bits + byte, num_bytes < 8 ? num_bytes : 8) >> shift;
+  if(num_bytes > 8 && shift) {
+    word |= (uint64_t)bits[byte + 8] << (64 - shift);
+  }
+  return size - start < 64 ? word & ((1ull << (size - start)) - 1) : word;
+}
+
+void fern_internal_reverse(fern_DataReader x, uint32_t stride, fern_Data result) {
+  uint32_t size = x.size;
+  void * dst = fern_init_data(result, x.format, size);
+  uint32_t n = stride ? size / stride : 0;
+
+  if(x.format == fern_Format_natural_1_bit && stride == 1) {
+    // result word k is the reversed source word ending at bit size - 64k
+    for(uint32_t i = 0; i < size; i += 64) {
+      uint32_t count = size - i < 64 ? size - i : 64;
+      uint64_t word = _reverse_bits(_bits_at(x.natural_1_bit, size, (int64_t)size - i - 64));
+      _store_bits((uint8_t *)dst + (i >> 3), (count + 7) >> 3, word);
+    }
+    return;
+  }
+
+  if(x.format != fern_Format_natural_1_bit && stride == 1) {
+    // a plain reversed loop per width, which the compiler turns into vector loads and shuffles
+    #define _REVERSE(T) \
+      { \
+        T * d = dst; \
+        const T * s = (const T *)x.pointer; \
+        for(uint32_t i = 0; i < size; i++) { \
+          d[i] = s[size - 1 - i]; \
+        } \
+      }
+    _BY_WIDTH(fern_internal_format_bit_size(x.format) >> 3, _REVERSE)
+    #undef _REVERSE
+    return;
+  }
+
+  for(uint32_t i = 0; i < n; i++) {
+    fern_internal_copy_cells(dst, i * stride, x, (n - 1 - i) * stride, stride);
+  }
+}
+
+void fern_internal_rotate(fern_DataReader x, uint32_t outer, uint32_t n, uint32_t stride, uint32_t amount, void * dst) {
+  uint32_t block = n * stride;
+  uint32_t head = amount * stride;
+  for(uint32_t o = 0; o < outer; o++) {
+    fern_internal_copy_cells(dst, o * block, x, o * block + head, block - head);
+    fern_internal_copy_cells(dst, o * block + block - head, x, o * block, head);
+  }
+}
+
+// tiles of the blocked transpose, 32 cells a side keeps both the source rows and the destination rows of a tile in L1
+#define _TILE 32
+
+// d[i * b + j] = s[j * s_stride + i] for a destination of a rows and b columns
+#define _TRANSPOSE(T) \
+  { \
+    T * d = (T *)dst + base_dst; \
+    const T * s = (const T *)x.pointer + base_src; \
+    for(uint32_t i0 = 0; i0 < a; i0 += _TILE) { \
+      for(uint32_t j0 = 0; j0 < b; j0 += _TILE) { \
+        if(i0 + _TILE <= a && j0 + _TILE <= b) { \
+          /* full tile, constant bounds so the compiler can unroll and keep the tile in registers */ \
+          for(uint32_t i = 0; i < _TILE; i++) { \
+            for(uint32_t j = 0; j < _TILE; j++) { \
+              d[(size_t)(i0 + i) * b + j0 + j] = s[(size_t)(j0 + j) * s_stride + i0 + i]; \
+            } \
+          } \
+        } else { \
+          uint32_t i1 = i0 + _TILE < a ? i0 + _TILE : a; \
+          uint32_t j1 = j0 + _TILE < b ? j0 + _TILE : b; \
+          for(uint32_t i = i0; i < i1; i++) { \
+            for(uint32_t j = j0; j < j1; j++) { \
+              d[(size_t)i * b + j] = s[(size_t)j * s_stride + i]; \
+            } \
+          } \
+        } \
+      } \
+    } \
+  }
+
+// d[i] = s[i * step] along the last axis
+#define _GATHER_STRIDED(T) \
+  { \
+    T * d = (T *)dst + base_dst; \
+    const T * s = (const T *)x.pointer + base_src; \
+    for(uint32_t i = 0; i < last; i++) { \
+      d[i] = s[(size_t)i * step]; \
+    } \
+  }
+
+void fern_internal_permute(fern_DataReader x, uint32_t rank, const uint32_t * shape, const uint32_t * strides, fern_Data result) {
+  // drop length 1 axes and merge neighbours that are already contiguous in x, which turns most permutations into a few axes
+  uint32_t * s_shape = malloc(sizeof(uint32_t) * (rank + 1) * 3);
+  uint32_t * s_strides = s_shape + rank + 1;
+  uint32_t * index = s_strides + rank + 1;
+  uint32_t r = 0;
+  uint64_t size = 1;
+  for(uint32_t k = 0; k < rank; k++) {
+    size *= shape[k];
+    if(shape[k] == 1) {
+      continue;
+    }
+    if(r > 0 && s_strides[r - 1] == (uint64_t)strides[k] * shape[k]) {
+      s_shape[r - 1] *= shape[k];
+      s_strides[r - 1] = strides[k];
+      continue;
+    }
+    s_shape[r] = shape[k];
+    s_strides[r] = strides[k];
+    r++;
+  }
+  void * dst = fern_init_data(result, x.format, size);
+  if(size == 0) {
+    free(s_shape);
+    return;
+  }
+  if(r == 0) {
+    s_shape[0] = 1;
+    s_strides[0] = 1;
+    r = 1;
+  }
+
+  uint32_t width = fern_internal_format_bit_size(x.format) >> 3;
+  uint32_t last = s_shape[r - 1];
+  uint32_t step = s_strides[r - 1];
+  bool transpose = x.format != fern_Format_natural_1_bit && r >= 2 && step != 1 && s_strides[r - 2] == 1;
+  // axes walked by the odometer, the innermost one or two are handled by the kernels
+  uint32_t outer_rank = transpose ? r - 2 : r - 1;
+  uint32_t chunk = transpose ? last * s_shape[r - 2] : last;
+
+  memset(index, 0, sizeof(uint32_t) * (outer_rank + 1));
+  uint64_t base_src = 0;
+  for(uint64_t base_dst = 0; base_dst < size; base_dst += chunk) {
+    if(step == 1) {
+      fern_internal_copy_cells(dst, base_dst, x, base_src, last);
+    } else if(transpose) {
+      uint32_t a = s_shape[r - 2];
+      uint32_t b = last;
+      uint32_t s_stride = step;
+      _BY_WIDTH(width, _TRANSPOSE)
+    } else if(x.format != fern_Format_natural_1_bit) {
+      _BY_WIDTH(width, _GATHER_STRIDED)
+    } else {
+      for(uint32_t i = 0; i < last; i++) {
+        _set_bit(dst, base_dst + i, _get_bit(x.natural_1_bit, base_src + (uint64_t)i * step));
+      }
+    }
+
+    for(int32_t k = (int32_t)outer_rank - 1; k >= 0; k--) {
+      base_src += s_strides[k];
+      if(++index[k] < s_shape[k]) {
+        break;
+      }
+      base_src -= (uint64_t)s_strides[k] * s_shape[k];
+      index[k] = 0;
+    }
+  }
+  free(s_shape);
+}
+
+#undef _TILE
+#undef _TRANSPOSE
+#undef _GATHER_STRIDED
+
+// select -----------------------------------------------------------------------------------------------------------------------------------------------------
+// sources larger than this are not expected to be in cache, the gather prefetches a few indices ahead
+#define _GATHER_PREFETCH_BYTES (1u << 18)
+#define _GATHER_PREFETCH_DISTANCE 16
+
+// boolean and boxed indices become 32 bit naturals in one pass, negative indices counting back from n
+static uint32_t * _select_indices(fern_DataReader w, uint32_t n) {
+  uint32_t * indices = malloc(sizeof(uint32_t) * (w.size ? w.size : 1));
+  bool in_bounds = true;
+  if(w.format == fern_Format_natural_1_bit) {
+    for(uint32_t i = 0; i < w.size; i++) {
+      indices[i] = _get_bit(w.natural_1_bit, i);
+      in_bounds &= indices[i] < n;
+    }
+  } else {
+    for(uint32_t i = 0; i < w.size; i++) {
+      fern_assert_fatal_error(fern_is_number(w.box[i]) && round(w.box[i].number) == w.box[i].number, "⊏: 𝕨 must consist of integers");
+      double k = w.box[i].number < 0 ? w.box[i].number + n : w.box[i].number;
+      in_bounds &= k >= 0 && k < n;
+      indices[i] = in_bounds ? (uint32_t)k : 0;
+    }
+  }
+  if(!in_bounds) {
+    free(indices);
+    fern_fatal_error("⊏: Indexing out-of-bounds");
+  }
+  return indices;
+}
+
+#define _GATHER(I, T) \
+  { \
+    T * d = dst; \
+    const T * s = (const T *)x.pointer; \
+    if(prefetch) { \
+      for(uint32_t i = 0; i < m; i++) { \
+        if(i + _GATHER_PREFETCH_DISTANCE < m) { \
+          __builtin_prefetch(s + idx[i + _GATHER_PREFETCH_DISTANCE]); \
+        } \
+        d[i] = s[idx[i]]; \
+      } \
+    } else { \
+      for(uint32_t i = 0; i < m; i++) { \
+        d[i] = s[idx[i]]; \
+      } \
+    } \
+  }
+
+#define _GATHER_INDEX(I) \
+  { \
+    const I * idx = (const I *)indices; \
+    if(x.format == fern_Format_natural_1_bit) { \
+      for(uint32_t i = 0; i < m; i++) { \
+        _set_bit(dst, i, _get_bit(x.natural_1_bit, idx[i])); \
+      } \
+    } else if(stride == 1) { \
+      switch(fern_internal_format_bit_size(x.format)) { \
+      case 8:  _GATHER(I, uint8_t)  break; \
+      case 16: _GATHER(I, uint16_t) break; \
+      case 32: _GATHER(I, uint32_t) break; \
+      default: _GATHER(I, uint64_t) break; \
+      } \
+    } else { \
+      for(uint32_t i = 0; i < m; i++) { \
+        fern_internal_copy_cells(dst, i * stride, x, (uint32_t)idx[i] * stride, stride); \
+      } \
+    } \
+  }
+
+void fern_internal_select(fern_DataReader w, fern_DataReader x, uint32_t n, uint32_t stride, fern_Data result) {
+  uint32_t m = w.size;
+  fern_assert_fatal_error((uint64_t)m * stride <= UINT32_MAX, "⊏: result too large");
+  fern_assert_fatal_error(w.format != fern_Format_character && w.format != fern_Format_symbol, "⊏: 𝕨 must consist of integers");
+  void * dst = fern_init_data(result, x.format, m * stride);
+  if(m == 0 || stride == 0) {
+    return;
+  }
+
+  // natural indices only need their maximum checked, in a single pass that vectorizes, before the unchecked gather
+  const void * indices = (const void *)w.pointer;
+  uint32_t * widened = NULL;
+  if(w.format == fern_Format_natural_1_bit || w.format == fern_Format_box) {
+    widened = _select_indices(w, n);
+    indices = widened;
+  } else {
+    fern_assert_fatal_error(_natural_max(w) < n, "⊏: Indexing out-of-bounds");
+  }
+
+  bool prefetch = (uint64_t)x.size * (fern_internal_format_bit_size(x.format) >> 3) > _GATHER_PREFETCH_BYTES;
+  switch(widened ? fern_Format_natural_32_bit : w.format) {
+  case fern_Format_natural_8_bit:  _GATHER_INDEX(uint8_t)  break;
+  case fern_Format_natural_16_bit: _GATHER_INDEX(uint16_t) break;
+  default:                         _GATHER_INDEX(uint32_t) break;
+  }
+  free(widened);
+}
+
+uint32_t * fern_internal_select_indices(fern_DataReader w, uint32_t n) {
+  fern_assert_fatal_error(w.format != fern_Format_character && w.format != fern_Format_symbol, "⊏: 𝕨 must consist of integers");
+  if(w.format == fern_Format_natural_1_bit || w.format == fern_Format_box) {
+    return _select_indices(w, n);
+  }
+  fern_assert_fatal_error(_natural_max(w) < n, "⊏: Indexing out-of-bounds");
+  uint32_t * indices = malloc(sizeof(uint32_t) * (w.size ? w.size : 1));
+  for(uint32_t i = 0; i < w.size; i++) {
+    indices[i] = fern_data_get_natural(w, i);
+  }
+  return indices;
+}
+
+#undef _GATHER_PREFETCH_BYTES
+#undef _GATHER_PREFETCH_DISTANCE
+#undef _GATHER
+#undef _GATHER_INDEX
+
+// join -------------------------------------------------------------------------------------------------------------------------------------------------------
+// natural formats are ordered by width, so the wider of two naturals holds both
+fern_Format fern_internal_unify_format(fern_Format a, fern_Format b) {
+  if(a == b) {
+    return a;
+  }
+  if(a <= fern_Format_natural_32_bit && b <= fern_Format_natural_32_bit) {
+    return a > b ? a : b;
+  }
+  return fern_Format_box;
+}
+
+void fern_internal_convert_cells(void * dst, fern_Format format, uint32_t dst_index, fern_DataReader src) {
+  if(src.format == format) {
+    fern_internal_copy_cells(dst, dst_index, src, 0, src.size);
+    return;
+  }
+  if(format == fern_Format_box) {
+    fern_Box * d = (fern_Box *)dst + dst_index;
+    for(uint32_t i = 0; i < src.size; i++) {
+      d[i] = fern_data_get_cell(src, i);
+    }
+    return;
+  }
+
+  // widening between naturals
+  #define _WIDEN(T) \
+    { \
+      T * d = (T *)dst + dst_index; \
+      switch(src.format) { \
+      case fern_Format_natural_1_bit: \
+        for(uint32_t i = 0; i < src.size; i++) { \
+          d[i] = _get_bit(src.natural_1_bit, i); \
+        } \
+        break; \
+      case fern_Format_natural_8_bit: \
+        for(uint32_t i = 0; i < src.size; i++) { \
+          d[i] = src.natural_8_bit[i]; \
+        } \
+        break; \
+      case fern_Format_natural_16_bit: \
+        for(uint32_t i = 0; i < src.size; i++) { \
+          d[i] = src.natural_16_bit[i]; \
+        } \
+        break; \
+      default: \
+        fern_fatal_error("invalid format"); \
+      } \
+    }
+  switch(format) {
+  case fern_Format_natural_8_bit:  _WIDEN(uint8_t)  break;
+  case fern_Format_natural_16_bit: _WIDEN(uint16_t) break;
+  case fern_Format_natural_32_bit: _WIDEN(uint32_t) break;
+  default:
+    fern_fatal_error("invalid format");
+  }
+  #undef _WIDEN
+}
+
+// reshape ----------------------------------------------------------------------------------------------------------------------------------------------------
+void fern_internal_cycle(fern_DataReader x, uint32_t size, fern_Data result) {
+  void * dst = fern_init_data(result, x.format, size);
+  uint32_t filled = x.size < size ? x.size : size;
+  fern_internal_copy_cells(dst, 0, x, 0, filled);
+
+  // the filled prefix is always whole repetitions of 𝕩, so copying all of it doubles the pattern with one memcpy
+  fern_DataReader pattern = fern_read_data(result);
+  while(filled < size) {
+    uint32_t count = size - filled < filled ? size - filled : filled;
+    fern_internal_copy_cells(dst, filled, pattern, 0, count);
+    filled += count;
+  }
+}
+
+// scalar arrays ----------------------------------------------------------------------------------------------------------------------------------------------
+// every cell of a numeric format as a double, false when a boxed cell is not a number
+static bool _as_doubles(fern_DataReader x, double * d) {
+  switch(x.format) {
+  case fern_Format_natural_1_bit:
+    for(uint32_t i = 0; i < x.size; i++) {
+      d[i] = _get_bit(x.natural_1_bit, i);
+    }
+    return true;
+  #define _CONVERT(T) for(uint32_t i = 0; i < x.size; i++) { d[i] = x.T[i]; } return true;
+  case fern_Format_natural_8_bit:  _CONVERT(natural_8_bit)
+  case fern_Format_natural_16_bit: _CONVERT(natural_16_bit)
+  case fern_Format_natural_32_bit: _CONVERT(natural_32_bit)
+  #undef _CONVERT
+  case fern_Format_box:
+    for(uint32_t i = 0; i < x.size; i++) {
+      if(!fern_is_number(x.box[i])) {
+        return false;
+      }
+      d[i] = x.box[i].number;
+    }
+    return true;
+  default:
+    return false;
+  }
+}
+
+// doubles stored in the narrowest format that holds all of them exactly, booleans and naturals before boxed numbers
+static void _from_doubles(const double * d, uint32_t n, fern_Data result) {
+  bool natural = true;
+  double max = 0;
+  for(uint32_t i = 0; i < n; i++) {
+    natural &= d[i] >= 0 && d[i] <= UINT32_MAX && d[i] == floor(d[i]);
+    max = d[i] > max ? d[i] : max;
+  }
+
+  if(!natural) {
+    fern_Box * r = fern_init_data(result, fern_Format_box, n);
+    for(uint32_t i = 0; i < n; i++) {
+      r[i] = fern_pack_number(d[i]);
+    }
+    return;
+  }
+  if(max <= 1) {
+    uint8_t * r = fern_init_data(result, fern_Format_natural_1_bit, n);
+    memset(r, 0, (n + 7) >> 3);
+    for(uint32_t i = 0; i < n; i++) {
+      r[i >> 3] |= (d[i] != 0) << (i & 7);
+    }
+    return;
+  }
+  fern_Format format = fern_internal_natural_format(max);
+  void * r = fern_init_data(result, format, n);
+  #define _NARROW(T) for(uint32_t i = 0; i < n; i++) { ((T *)r)[i] = d[i]; }
+  switch(format) {
+  case fern_Format_natural_8_bit:  _NARROW(uint8_t)  break;
+  case fern_Format_natural_16_bit: _NARROW(uint16_t) break;
+  default:                         _NARROW(uint32_t) break;
+  }
+  #undef _NARROW
+}
+
+static inline double _scalar_monad(fern_ScalarOp op, double x) {
+  switch(op) {
+  case fern_ScalarOp_add:      return x;
+  case fern_ScalarOp_subtract: return -x;
+  case fern_ScalarOp_multiply: return (x > 0) - (x < 0);
+  case fern_ScalarOp_divide:   return 1 / x;
+  case fern_ScalarOp_max:      return ceil(x);
+  case fern_ScalarOp_min:      return floor(x);
+  default:                     fern_fatal_error("invalid scalar op");
+  }
+}
+
+bool fern_internal_scalar_monad_op(fern_ScalarOp op) {
+  switch(op) {
+  case fern_ScalarOp_add:
+  case fern_ScalarOp_subtract:
+  case fern_ScalarOp_multiply:
+  case fern_ScalarOp_divide:
+  case fern_ScalarOp_max:
+  case fern_ScalarOp_min:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// the op is switched on outside of the loops, so each loop is a plain vectorizable pass over doubles
+#define _EACH_DYAD(W, W_STEP, X_STEP) \
+  switch(op) { \
+  case fern_ScalarOp_add:       for(uint32_t i = 0; i < n; i++) { r[i] = W[i * W_STEP] + xd[i * X_STEP]; } break; \
+  case fern_ScalarOp_subtract:  for(uint32_t i = 0; i < n; i++) { r[i] = W[i * W_STEP] - xd[i * X_STEP]; } break; \
+  case fern_ScalarOp_multiply: \
+  case fern_ScalarOp_and:       for(uint32_t i = 0; i < n; i++) { r[i] = W[i * W_STEP] * xd[i * X_STEP]; } break; \
+  case fern_ScalarOp_divide:    for(uint32_t i = 0; i < n; i++) { r[i] = W[i * W_STEP] / xd[i * X_STEP]; } break; \
+  case fern_ScalarOp_max:       for(uint32_t i = 0; i < n; i++) { r[i] = fmax(W[i * W_STEP], xd[i * X_STEP]); } break; \
+  case fern_ScalarOp_min:       for(uint32_t i = 0; i < n; i++) { r[i] = fmin(W[i * W_STEP], xd[i * X_STEP]); } break; \
+  default:                      for(uint32_t i = 0; i < n; i++) { r[i] = _scalar_op(op, W[i * W_STEP], xd[i * X_STEP]); } break; \
+  }
+
+bool fern_internal_scalar_each(fern_ScalarOp op, bool monad, fern_DataReader x, fern_DataReader w, fern_Data result) {
+  uint32_t n = monad || x.size > w.size ? x.size : w.size;
+  if(op == fern_ScalarOp_none || (monad && !fern_internal_scalar_monad_op(op))) {
+    return false;
+  }
+  if(x.size != n && x.size != 1) {
+    return false;
+  }
+  if(!monad && w.size != n && w.size != 1) {
+    return false;
+  }
+
+  double * xd = malloc(sizeof(double) * (x.size + (monad ? 0 : w.size) + n + 1));
+  double * wd = xd + x.size;
+  double * r = wd + (monad ? 0 : w.size);
+  if(!_as_doubles(x, xd) || (!monad && !_as_doubles(w, wd))) {
+    free(xd);
+    return false;
+  }
+
+  if(monad) {
+    for(uint32_t i = 0; i < n; i++) {
+      r[i] = _scalar_monad(op, xd[i]);
+    }
+  } else if(x.size == w.size) {
+    _EACH_DYAD(wd, 1, 1)
+  } else if(w.size == 1) {
+    _EACH_DYAD(wd, 0, 1)
+  } else {
+    _EACH_DYAD(wd, 1, 0)
+  }
+
+  _from_doubles(r, n, result);
+  free(xd);
+  return true;
+}
+
+bool fern_internal_scalar_table(fern_ScalarOp op, fern_DataReader x, fern_DataReader w, fern_Data result) {
+  if(op == fern_ScalarOp_none) {
+    return false;
+  }
+  uint64_t size = (uint64_t)x.size * w.size;
+  fern_assert_fatal_error(size <= UINT32_MAX, "⌜: result too large");
+
+  double * xd = malloc(sizeof(double) * (x.size + w.size + size + 1));
+  double * wd = xd + x.size;
+  double * rd = wd + w.size;
+  if(!_as_doubles(x, xd) || !_as_doubles(w, wd)) {
+    free(xd);
+    return false;
+  }
+
+  // one row per cell of 𝕨, each row a broadcast of that cell against all of 𝕩
+  uint32_t n = x.size;
+  for(uint32_t j = 0; j < w.size; j++) {
+    double * r = rd + (size_t)j * n;
+    const double * row = wd + j;
+    _EACH_DYAD(row, 0, 1)
+  }
+
+  _from_doubles(rd, size, result);
+  free(xd);
+  return true;
+}
+
+// a tree of scalar primitives evaluated one strip of cells at a time, so no intermediate outgrows a strip. single cells and
+// constants are converted once and broadcast, as is a step on broadcast operands only
+#define _FUSED_STRIP 512
+
+static bool _strip_doubles(fern_DataReader x, uint32_t start, uint32_t length, double * d) {
+  uint64_t bit_start = (uint64_t)fern_internal_format_bit_size(x.format) * start;
+  fern_DataReader strip = { .format = x.format, .size = length, .pointer = x.pointer + (bit_start >> 3) };
+  return _as_doubles(strip, d);
+}
+
+bool fern_internal_scalar_fused(const fern_ScalarProgram * program, const fern_DataReader * inputs, uint32_t num_inputs, fern_Data result) {
+  uint32_t size = 1;
+  for(uint32_t k = 0; k < num_inputs; k++) {
+    size = inputs[k].size != 1 ? inputs[k].size : size;
+  }
+  for(uint32_t k = 0; k < num_inputs; k++) {
+    if(inputs[k].size != size && inputs[k].size != 1) {
+      return false;
+    }
+  }
+
+  // an input read before, as 𝕩 of a monad is also 𝕨, shares the strip of the first
+  uint32_t first_step = num_inputs + program->num_consts;
+  uint32_t num_strips = num_inputs + program->num_steps;
+  double * strips = malloc(sizeof(double) * ((size_t)_FUSED_STRIP * num_strips + size + 1));
+  double * rd = strips + (size_t)_FUSED_STRIP * num_strips;
+  const double * operand[3 * fern_CLOSURE_MAX];
+  bool broadcast[3 * fern_CLOSURE_MAX];
+  bool converted[fern_CLOSURE_MAX];
+  double cells[fern_CLOSURE_MAX];
+  for(uint32_t k = 0; k < program->num_consts; k++) {
+    operand[num_inputs + k] = program->consts + k;
+    broadcast[num_inputs + k] = true;
+  }
+  for(uint32_t k = 0; k < num_inputs; k++) {
+    uint32_t same = 0;
+    while(same < k && (inputs[same].pointer != inputs[k].pointer || inputs[same].format != inputs[k].format || inputs[same].size != inputs[k].size)) {
+      same++;
+    }
+    converted[k] = same == k;
+    broadcast[k] = inputs[k].size == 1;
+    operand[k] = !converted[k] ? operand[same] : broadcast[k] ? cells + k : strips + (size_t)_FUSED_STRIP * k;
+    if(converted[k] && broadcast[k] && !_as_doubles(inputs[k], cells + k)) {
+      free(strips);
+      return false;
+    }
+  }
+
+  for(uint32_t start = 0; start < size; start += _FUSED_STRIP) {
+    uint32_t length = size - start < _FUSED_STRIP ? size - start : _FUSED_STRIP;
+    for(uint32_t k = 0; k < num_inputs; k++) {
+      if(converted[k] && !broadcast[k] && !_strip_doubles(inputs[k], start, length, strips + (size_t)_FUSED_STRIP * k)) {
+        free(strips);
+        return false;
+      }
+    }
+    for(uint32_t i = 0; i < program->num_steps; i++) {
+      const fern_ScalarStep * step = program->steps + i;
+      fern_ScalarOp op = step->op;
+      double * r = strips + (size_t)_FUSED_STRIP * (num_inputs + i);
+      const double * xd = operand[step->x];
+      const double * wd = operand[step->w];
+      bool bx = broadcast[step->x];
+      bool bw = step->monad || broadcast[step->w];
+      uint32_t n = bx && bw ? 1 : length;
+      operand[first_step + i] = r;
+      broadcast[first_step + i] = bx && bw;
+      if(step->monad) {
+        for(uint32_t j = 0; j < n; j++) {
+          r[j] = _scalar_monad(op, xd[bx ? 0 : j]);
+        }
+      } else if(!bw && !bx) {
+        _EACH_DYAD(wd, 1, 1)
+      } else if(bw && !bx) {
+        _EACH_DYAD(wd, 0, 1)
+      } else if(!bw) {
+        _EACH_DYAD(wd, 1, 0)
+      } else {
+        _EACH_DYAD(wd, 0, 0)
+      }
+    }
+    if(broadcast[program->result]) {
+      for(uint32_t j = 0; j < length; j++) {
+        rd[start + j] = operand[program->result][0];
+      }
+    } else {
+      memcpy(rd + start, operand[program->result], sizeof(double) * length);
+    }
+  }
+
+  _from_doubles(rd, size, result);
+  free(strips);
+  return true;
+}
+
+#undef _FUSED_STRIP
+#undef _EACH_DYAD
+
+double fern_internal_scalar_identity(fern_ScalarOp op) {
+  switch(op) {
+  case fern_ScalarOp_multiply:
+  case fern_ScalarOp_and:
+  case fern_ScalarOp_divide:
+  case fern_ScalarOp_equal:
+    return 1;
+  case fern_ScalarOp_max:
+    return -INFINITY;
+  case fern_ScalarOp_min:
+    return INFINITY;
+  default:
+    return 0;
+  }
+}
+
+bool fern_internal_scalar_fold(fern_ScalarOp op, fern_DataReader x, uint32_t rows, uint32_t length, fern_Data result) {
+  if(op == fern_ScalarOp_none) {
+    return false;
+  }
+  if(length == 0) {
+    double * rd = malloc(sizeof(double) * (rows + 1));
+    for(uint32_t j = 0; j < rows; j++) {
+      rd[j] = fern_internal_scalar_identity(op);
+    }
+    _from_doubles(rd, rows, result);
+    free(rd);
+    return true;
+  }
+  double * xd = malloc(sizeof(double) * (x.size + rows + 1));
+  double * rd = xd + x.size;
+  if(!_as_doubles(x, xd)) {
+    free(xd);
+    return false;
+  }
+
+  // a right fold, x₀ 𝔽 (x₁ 𝔽 …), evaluated from the end of each row
+  for(uint32_t j = 0; j < rows; j++) {
+    const double * row = xd + (size_t)j * length;
+    double acc = row[length - 1];
+    for(uint32_t i = length - 1; i-- > 0;) {
+      acc = _scalar_op(op, row[i], acc);
+    }
+    rd[j] = acc;
+  }
+
+  _from_doubles(rd, rows, result);
+  free(xd);
+  return true;
+}
+
+// repeat -----------------------------------------------------------------------------------------------------------------------------------------------------
+// whether 𝕨ⁿ by squaring gives exactly what n steps would: ⌈ ⌊ always do, + and × when every partial result is an integer
+// below 2⁵³, ∨ and ∧ of booleans
+static bool _repeat_exact(fern_ScalarOp op, const double * x, uint32_t n, const double * w, uint32_t wn, uint64_t count) {
+  if(op == fern_ScalarOp_max || op == fern_ScalarOp_min) {
+    return true;
+  }
+  bool integer = true;
+  bool boolean = true;
+  double x_max = 0;
+  double w_max = 0;
+  for(uint32_t i = 0; i < n; i++) {
+    integer &= x[i] == floor(x[i]);
+    boolean &= x[i] == 0 || x[i] == 1;
+    x_max = fabs(x[i]) > x_max ? fabs(x[i]) : x_max;
+  }
+  for(uint32_t i = 0; i < wn; i++) {
+    integer &= w[i] == floor(w[i]);
+    boolean &= w[i] == 0 || w[i] == 1;
+    w_max = fabs(w[i]) > w_max ? fabs(w[i]) : w_max;
+  }
+  const double limit = 9007199254740992.0;
+  switch(op) {
+  case fern_ScalarOp_add:
+    return integer && x_max + (double)count * w_max <= limit;
+  case fern_ScalarOp_multiply:
+  case fern_ScalarOp_and:
+    if(boolean) {
+      return true;
+    }
+    return integer && (w_max <= 1 ? x_max <= limit : count < 64 && x_max * pow(w_max, count) <= limit);
+  case fern_ScalarOp_or:
+    return boolean;
+  default:
+    return false;
+  }
+}
+
+bool fern_internal_scalar_repeat(fern_ScalarOp op, bool monad, fern_DataReader x, fern_DataReader w, uint64_t count, fern_Data result) {
+  if(op == fern_ScalarOp_none || (monad && !fern_internal_scalar_monad_op(op))) {
+    return false;
+  }
+  if(!monad && w.size != x.size && w.size != 1) {
+    return false;
+  }
+
+  uint32_t n = x.size;
+  uint32_t wn = monad ? 0 : w.size;
+  uint32_t w_step = wn == 1 ? 0 : 1;
+  double * r = malloc(sizeof(double) * (n + wn * 2 + 1));
+  double * wd = r + n;
+  double * base = wd + wn;
+  if(!_as_doubles(x, r) || (!monad && !_as_doubles(w, wd))) {
+    free(r);
+    return false;
+  }
+
+  if(monad) {
+    // - is its own inverse, everything else steps until count or until no cell changes
+    if(op == fern_ScalarOp_subtract) {
+      count &= 1;
+    }
+    for(uint64_t k = 0; k < count; k++) {
+      bool changed = false;
+      for(uint32_t i = 0; i < n; i++) {
+        double v = _scalar_monad(op, r[i]);
+        changed |= v != r[i];
+        r[i] = v;
+      }
+      if(!changed) {
+        break;
+      }
+    }
+  } else if(_repeat_exact(op, r, n, wd, wn, count)) {
+    // the op is associative and commutative, so 𝕨 𝔽 (𝕨 𝔽 … 𝕩) is 𝕨ⁿ 𝔽 𝕩 with 𝕨ⁿ found by repeated squaring
+    memcpy(base, wd, sizeof(double) * wn);
+    while(count) {
+      if(count & 1) {
+        for(uint32_t i = 0; i < n; i++) {
+          r[i] = _scalar_op(op, base[i * w_step], r[i]);
+        }
+      }
+      count >>= 1;
+      if(count) {
+        for(uint32_t i = 0; i < wn; i++) {
+          base[i] = _scalar_op(op, base[i], base[i]);
+        }
+      }
+    }
+  } else {
+    for(uint64_t k = 0; k < count; k++) {
+      bool changed = false;
+      for(uint32_t i = 0; i < n; i++) {
+        double v = _scalar_op(op, wd[i * w_step], r[i]);
+        changed |= v != r[i];
+        r[i] = v;
+      }
+      if(!changed) {
+        break;
+      }
+    }
+  }
+
+  _from_doubles(r, n, result);
+  free(r);
+  return true;
+}
+
+// under ------------------------------------------------------------------------------------------------------------------------------------------------------
+fern_Box fern_internal_owned = { .bits = FERN_BOX_NAN_QUIET | ((uint64_t)fern_Tag_symbol << 48) };
+fern_Box fern_internal_fresh = { .bits = FERN_BOX_NAN_QUIET | ((uint64_t)fern_Tag_symbol << 48) };
+
+fern_Format fern_internal_cell_format(fern_DataReader x) {
+  if(x.format != fern_Format_box || x.size == 0) {
+    return x.format;
+  }
+  uint64_t tag = fern_tag(x.box[0]);
+  double max = 0;
+  for(uint32_t i = 0; i < x.size; i++) {
+    if(fern_tag(x.box[i]) != tag) {
+      return fern_Format_box;
+    }
+    if(tag == fern_Tag_number) {
+      double k = x.box[i].number;
+      if(!(k >= 0 && k <= UINT32_MAX && k == floor(k))) {
+        return fern_Format_box;
+      }
+      max = k > max ? k : max;
+    }
+  }
+  switch(tag) {
+  case fern_Tag_number:    return max <= 1 ? fern_Format_natural_1_bit : fern_internal_natural_format(max);
+  case fern_Tag_character: return fern_Format_character;
+  case fern_Tag_symbol:    return fern_Format_symbol;
+  default:                 return fern_Format_box;
+  }
+}
+
+// a cell that `format` can hold, see fern_internal_cell_format
+static inline void _store_cell(void * dst, fern_Format format, uint32_t index, fern_Box cell) {
+  switch(format) {
+  case fern_Format_natural_1_bit:  _set_bit(dst, index, cell.number != 0);                   break;
+  case fern_Format_natural_8_bit:  ((uint8_t *)dst)[index] = cell.number;                    break;
+  case fern_Format_natural_16_bit: ((uint16_t *)dst)[index] = cell.number;                   break;
+  case fern_Format_natural_32_bit: ((uint32_t *)dst)[index] = cell.number;                   break;
+  case fern_Format_character:      ((char32_t *)dst)[index] = fern_unpack_character(cell);   break;
+  case fern_Format_symbol:         ((uint32_t *)dst)[index] = fern_unpack_symbol(cell);      break;
+  case fern_Format_box:            ((fern_Box *)dst)[index] = cell;                          break;
+  default:                         fern_fatal_error("invalid format");
+  }
+}
+
+static int _compare_positions(const void * a, const void * b) {
+  uint32_t pa = *(const uint32_t *)a;
+  uint32_t pb = *(const uint32_t *)b;
+  return (pa > pb) - (pa < pb);
+}
+
+bool fern_internal_scatter(void * dst, fern_Format format, const uint32_t * positions, uint32_t count, uint32_t stride, fern_DataReader values) {
+  uint32_t end = 0;
+  for(uint32_t k = 0; k < count; k++) {
+    uint32_t p = positions[k] * stride;
+    if(values.format == format) {
+      fern_internal_copy_cells(dst, p, values, k * stride, stride);
+    } else {
+      for(uint32_t j = 0; j < stride; j++) {
+        _store_cell(dst, format, p + j, fern_data_get_cell(values, k * stride + j));
+      }
+    }
+    end = p + stride > end ? p + stride : end;
+  }
+  if(count < 2 || stride == 0) {
+    return true;
+  }
+
+  // later writes win, so a position given more than once must have been given matching cells each time. sorting a copy of
+  // the positions keeps the check O(k log k) however large the target is
+  uint32_t * sorted = malloc(sizeof(uint32_t) * count);
+  memcpy(sorted, positions, sizeof(uint32_t) * count);
+  qsort(sorted, count, sizeof(uint32_t), _compare_positions);
+  bool repeated = false;
+  for(uint32_t k = 1; k < count && !repeated; k++) {
+    repeated = sorted[k] == sorted[k - 1];
+  }
+  free(sorted);
+  if(!repeated) {
+    return true;
+  }
+
+  fern_DataReader written = { .format = format, .size = end, .pointer = (uintptr_t)dst };
+  for(uint32_t k = 0; k < count; k++) {
+    for(uint32_t j = 0; j < stride; j++) {
+      if(!fern_internal_match(fern_data_get_cell(written, positions[k] * stride + j), fern_data_get_cell(values, k * stride + j))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// find -------------------------------------------------------------------------------------------------------------------------------------------------------
+// formats whose cells can be compared as plain integers, with a holding every cell of b
+static inline bool _find_fits(fern_Format b, fern_Format a) {
+  return a == b || (a <= fern_Format_natural_32_bit && b <= a);
+}
+
+// positions of x whose cell equals the first cell of w and whose cell m - 1 further equals the last, 64 positions at a time
+// with no branches so the compares vectorize. only the candidates are compared in full
+#define _FIND_RUN(T) \
+  { \
+    const T * xs = (const T *)x.pointer + x_start; \
+    const T * ws = (const T *)w.pointer + w_start; \
+    T first = ws[0]; \
+    T last = ws[m - 1]; \
+    for(uint32_t i = 0; i < count; i += 64) { \
+      uint32_t block = count - i < 64 ? count - i : 64; \
+      uint64_t candidates = 0; \
+      for(uint32_t b = 0; b < block; b++) { \
+        candidates |= (uint64_t)((xs[i + b] == first) & (xs[i + b + m - 1] == last)) << b; \
+      } \
+      uint64_t found = m <= 2 ? candidates : 0; \
+      for(uint64_t c = m <= 2 ? 0 : candidates; c; c &= c - 1) { \
+        uint32_t b = __builtin_ctzll(c); \
+        if(memcmp(xs + i + b + 1, ws + 1, sizeof(T) * (m - 2)) == 0) { \
+          found |= 1ull << b; \
+        } \
+      } \
+      _store_bits(bits + (i >> 3), (block + 7) >> 3, found); \
+    } \
+  }
+
+// bit i of bits is set when the m cells of w from w_start match the cells of x from x_start + i, for i < count. w has the
+// format of x, which is not natural_1_bit
+static void _find_run(fern_DataReader w, uint32_t w_start, uint32_t m, fern_DataReader x, uint32_t x_start, uint32_t count, uint8_t * bits) {
+  if(m == 0) {
+    memset(bits, 0xff, (count + 7) >> 3);
+    return;
+  }
+  if(x.format == fern_Format_box) {
+    // 0 and ¯0 match without having the same bits, so boxes are compared as values
+    memset(bits, 0, (count + 7) >> 3);
+    for(uint32_t i = 0; i < count; i++) {
+      uint32_t j = 0;
+      while(j < m && fern_internal_match(x.box[x_start + i + j], fern_data_get_cell(w, w_start + j))) {
+        j++;
+      }
+      _set_bit(bits, i, j == m);
+    }
+    return;
+  }
+  switch(fern_internal_format_bit_size(x.format)) {
+  case 8:  _FIND_RUN(uint8_t)  break;
+  case 16: _FIND_RUN(uint16_t) break;
+  default: _FIND_RUN(uint32_t) break;
+  }
+}
+
+#undef _FIND_RUN
+
+// the format w is compared in: naturals by the largest of them rather than by how they are stored, as a view such as 2↑
+// keeps the format of a wider argument
+static fern_Format _find_format(fern_DataReader w) {
+  if(w.format != fern_Format_natural_16_bit && w.format != fern_Format_natural_32_bit) {
+    return fern_internal_cell_format(w);
+  }
+  int64_t max = 0;
+  for(uint32_t i = 0; i < w.size; i++) {
+    int64_t k = fern_data_get_natural(w, i);
+    max = k > max ? k : max;
+  }
+  return max <= 1 ? fern_Format_natural_1_bit : fern_internal_natural_format(max);
+}
+
+static fern_DataReader _find_bytes(fern_DataReader x, fern_Data bytes) {
+  fern_internal_convert_cells(fern_init_data(bytes, fern_Format_natural_8_bit, x.size), fern_Format_natural_8_bit, 0, x);
+  return fern_read_data(bytes);
+}
+
+void fern_internal_find(fern_DataReader w, const uint32_t * w_shape, fern_DataReader x, const uint32_t * x_shape, uint32_t rank, fern_Data result) {
+  uint32_t rows = 1;
+  uint32_t w_rows = 1;
+  for(uint32_t k = 0; k + 1 < rank; k++) {
+    rows *= x_shape[k] >= w_shape[k] ? x_shape[k] - w_shape[k] + 1 : 0;
+    w_rows *= w_shape[k];
+  }
+  uint32_t length = x_shape[rank - 1];
+  uint32_t m = w_shape[rank - 1];
+  uint32_t cols = length >= m ? length - m + 1 : 0;
+  uint8_t * bits = fern_init_data(result, fern_Format_natural_1_bit, rows * cols);
+  memset(bits, 0, ((uint64_t)rows * cols + 7) >> 3);
+  if(rows == 0 || cols == 0) {
+    return;
+  }
+
+  // booleans are compared as bytes, and 𝕨 is brought into the format of 𝕩. when it cannot be, nothing matches
+  fern_Format w_format = _find_format(w);
+  fern_Format x_format = x.format == fern_Format_natural_1_bit ? fern_Format_natural_8_bit : x.format;
+  if(x_format != fern_Format_box && !_find_fits(w_format, x_format)) {
+    return;
+  }
+  union fern_Data x_bytes = { .inplace = { .is_pointer = 0 } };
+  union fern_Data w_cells;
+  fern_DataReader xr = x.format == x_format ? x : _find_bytes(x, &x_bytes);
+  void * wd = fern_init_data(&w_cells, xr.format, w.size);
+  for(uint32_t i = 0; i < w.size; i++) {
+    _store_cell(wd, xr.format, i, fern_data_get_cell(w, i));
+  }
+  fern_DataReader wr = fern_read_data(&w_cells);
+
+  if(rank == 1) {
+    _find_run(wr, 0, m, xr, 0, cols, bits);
+    if(cols & 7) {
+      bits[cols >> 3] &= (1 << (cols & 7)) - 1;
+    }
+  } else {
+    // a window matches when every row of 𝕨 matches the row of 𝕩 it lands on, so the row masks are and-ed together
+    uint32_t words = (cols + 63) >> 6;
+    uint64_t * match = malloc(sizeof(uint64_t) * words * 2);
+    uint64_t * row = match + words;
+    uint32_t * q = calloc(rank * 2, sizeof(uint32_t));
+    uint32_t * j = q + rank;
+    for(uint32_t r = 0; r < rows; r++) {
+      memset(match, 0xff, sizeof(uint64_t) * words);
+      memset(j, 0, sizeof(uint32_t) * rank);
+      bool any = true;
+      for(uint32_t s = 0; s < w_rows && any; s++) {
+        uint32_t x_row = 0;
+        for(uint32_t k = 0; k + 1 < rank; k++) {
+          x_row = x_row * x_shape[k] + q[k] + j[k];
+        }
+        _find_run(wr, s * m, m, xr, x_row * length, cols, (uint8_t *)row);
+        any = false;
+        for(uint32_t i = 0; i < words; i++) {
+          match[i] &= _load_bits((const uint8_t *)(row + i), 8);
+          any |= match[i] != 0;
+        }
+        if(cols & 63) {
+          match[words - 1] &= (1ull << (cols & 63)) - 1;
+        }
+        for(uint32_t k = rank - 1; k-- > 0 && ++j[k] == w_shape[k];) {
+          j[k] = 0;
+        }
+      }
+      for(uint32_t i = 0; i < words; i++) {
+        _store_bits((uint8_t *)(match + i), 8, match[i]);
+      }
+      fern_DataReader mr = { .format = fern_Format_natural_1_bit, .size = cols, .natural_1_bit = (const uint8_t *)match };
+      fern_internal_copy_cells(bits, r * cols, mr, 0, cols);
+      for(uint32_t k = rank - 1; k-- > 0 && ++q[k] == x_shape[k] - w_shape[k] + 1;) {
+        q[k] = 0;
+      }
+    }
+    free(q);
+    free(match);
+  }
+
+  fern_free_data(&w_cells);
+  fern_free_data(&x_bytes);
+}
+
+// take -------------------------------------------------------------------------------------------------------------------------------------------------------
+void fern_internal_fill_cells(void * dst, fern_Format format, uint32_t dst_index, uint32_t count, fern_Box fill) {
+  if(count == 0) {
+    return;
+  }
+  bool zero = format <= fern_Format_natural_32_bit && fill.bits == fern_pack_number(0).bits;
+  if(zero && format == fern_Format_natural_1_bit) {
+    // partial bytes at either end, whole bytes in between
+    uint32_t i = dst_index;
+    uint32_t end = dst_index + count;
+    for(; i < end && (i & 7); i++) {
+      _set_bit(dst, i, false);
+    }
+    if(i + 8 <= end) {
+      memset((uint8_t *)dst + (i >> 3), 0, (end - i) >> 3);
+      i += (end - i) & ~7u;
+    }
+    for(; i < end; i++) {
+      _set_bit(dst, i, false);
+    }
+    return;
+  }
+  if(zero) {
+    uint32_t cell_size = fern_internal_format_bit_size(format) >> 3;
+    memset((uint8_t *)dst + (size_t)dst_index * cell_size, 0, (size_t)count * cell_size);
+    return;
+  }
+  for(uint32_t i = 0; i < count; i++) {
+    _store_cell(dst, format, dst_index + i, fill);
+  }
+}
+
+void fern_internal_convert_range(void * dst, fern_Format format, uint32_t dst_index, fern_DataReader src, uint32_t src_index, uint32_t count) {
+  if(src.format == format) {
+    fern_internal_copy_cells(dst, dst_index, src, src_index, count);
+    return;
+  }
+  // boxed cells are unboxed one by one, fern_internal_convert_cells only widens
+  if(src.format != fern_Format_box && (src.format != fern_Format_natural_1_bit || (src_index & 7) == 0)) {
+    uint64_t bit_start = (uint64_t)fern_internal_format_bit_size(src.format) * src_index;
+    fern_DataReader range = { .format = src.format, .size = count, .pointer = src.pointer + (bit_start >> 3) };
+    fern_internal_convert_cells(dst, format, dst_index, range);
+    return;
+  }
+  for(uint32_t i = 0; i < count; i++) {
+    _store_cell(dst, format, dst_index + i, fern_data_get_cell(src, src_index + i));
+  }
+}
+
+void fern_internal_crop(fern_DataReader x, const uint32_t * x_shape, const uint32_t * shape, const int64_t * offset, uint32_t rank, fern_Box fill, fern_Format format, fern_Data result) {
+  uint64_t size = 1;
+  for(uint32_t k = 0; k < rank; k++) {
+    size *= shape[k];
+  }
+  fern_assert_fatal_error(size <= UINT32_MAX, "↑: result too large");
+  void * dst = fern_init_data(result, format, size);
+  if(size == 0) {
+    return;
+  }
+
+  // result cells [lo, hi) of every row come from 𝕩, the rest are fills
+  uint32_t length = shape[rank - 1];
+  uint32_t x_length = x_shape[rank - 1];
+  int64_t o = offset[rank - 1];
+  int64_t lo = -o < 0 ? 0 : -o > length ? length : -o;
+  int64_t hi = (int64_t)x_length - o < lo ? lo : (int64_t)x_length - o > length ? length : (int64_t)x_length - o;
+
+  uint32_t rows = size / length;
+  uint32_t * index = calloc(rank, sizeof(uint32_t));
+  for(uint32_t r = 0; r < rows; r++) {
+    bool inside = true;
+    uint64_t src_row = 0;
+    for(uint32_t k = 0; k + 1 < rank; k++) {
+      int64_t s = index[k] + offset[k];
+      inside &= s >= 0 && s < x_shape[k];
+      src_row = src_row * x_shape[k] + (inside ? s : 0);
+    }
+    uint32_t d = r * length;
+    uint64_t src = src_row * x_length + lo + o;
+    // cells past the end of the data of 𝕩 read as fills too
+    int64_t count = !inside ? 0 : src + (hi - lo) <= x.size ? hi - lo : src < x.size ? x.size - src : 0;
+    if(count == 0) {
+      fern_internal_fill_cells(dst, format, d, length, fill);
+    } else {
+      fern_internal_fill_cells(dst, format, d, lo, fill);
+      fern_internal_convert_range(dst, format, d + lo, x, src, count);
+      fern_internal_fill_cells(dst, format, d + lo + count, length - lo - count, fill);
+    }
+    for(uint32_t k = rank - 1; k-- > 0 && ++index[k] == shape[k];) {
+      index[k] = 0;
+    }
+  }
+  free(index);
+}
@@ -40,19 +40,40 @@ fern_Box fern_GREATER_THAN_SIGN(void);
 fern_Box fern_GREATER_THAN_OR_EQUAL_TO(void);                                         // ≥
 fern_Box fern_EQUAL_SIGN(void);                                                       // =
 fern_Box fern_NOT_EQUAL_SIGN(void);                                                   // ≠
+fern_Box fern_LOGICAL_AND(void);                                                      // ∧
+fern_Box fern_LOGICAL_OR(void);                                                       // ∨
 fern_Box fern_NOT_IDENTICAL_TO(void);                                                 // ≢
 fern_Box fern_LEFT_TACK(void);                                                        // ⊣
 fern_Box fern_RIGHT_TACK(void);                                                       // ⊢
 fern_Box fern_LEFT_BARB_UP_RIGHT_BARB_DOWN_HARPOON(void);                             // ⥊
+fern_Box fern_INVERTED_LAZY_S(void);                                                  // ∾
+fern_Box fern_EQUIVALENT_TO(void);                                                    // ≍
+fern_Box fern_UPWARDS_ARROW(void);                                                    // ↑
+fern_Box fern_DOWNWARDS_ARROW(void);                                                  // ↓
 fern_Box fern_UP_DOWN_ARROW(void);                                                    // ↕
+fern_Box fern_LEFT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK(void);                        // «
+fern_Box fern_RIGHT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK(void);                       // »
+fern_Box fern_SOLIDUS(void);                                                          // /
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_DELTA_STILE(void);                                 // ⍋
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_DEL_STILE(void);                                   // ⍒
+fern_Box fern_SQUARE_IMAGE_OF(void);                                                  // ⊏
 fern_Box fern_SQUARE_IMAGE_OF_OR_EQUAL_TO(void);                                      // ⊑
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STILE(void);                                // ⌽
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_BACKSLASH(void);                            // ⍉
+fern_Box fern_SQUARE_ORIGINAL_OF(void);                                               // ⊐
+fern_Box fern_SQUARE_ORIGINAL_OF_OR_EQUAL_TO(void);                                   // ⊒
+fern_Box fern_SMALL_ELEMENT_OF(void);                                                 // ∊
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_EPSILON_UNDERBAR(void);                            // ⍷
+fern_Box fern_SQUARE_CUP(void);                                                       // ⊔
 fern_Box fern_EXCLAMATION_MARK(void);                                                 // !
 
 // modifier-1 primitives
 fern_Box fern_DOT_ABOVE(void);                                                        // ˙ constant
 fern_Box fern_SMALL_TILDE(void);                                                      // ˜ swap
+fern_Box fern_BREVE(void);                                                            // ˘ cells
 fern_Box fern_DIAERESIS(void);                                                        // ¨ each
 fern_Box fern_TOP_LEFT_CORNER(void);                                                  // ⌜ table
+fern_Box fern_ACUTE_ACCENT(void);                                                     // ´ fold
 fern_Box fern_GRAVE_ACCENT(void);                                                     // ` scan
 
 // modifier-2 primitives
@@ -60,15 +81,19 @@ fern_Box fern_RING_OPERATOR(void);
 fern_Box fern_WHITE_CIRCLE(void);                                                     // ○ over
 fern_Box fern_MULTIMAP(void);                                                         // ⊸ before
 fern_Box fern_LEFT_MULTIMAP(void);                                                    // ⟜ after
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_JOT(void);                                  // ⌾ under
 fern_Box fern_CIRCLED_DIVISION_SLASH(void);                                           // ⊘ valences
 fern_Box fern_WHITE_CIRCLE_WITH_LOWER_RIGHT_QUADRANT(void);                           // ◶ choose
 fern_Box fern_CIRCLED_TRIANGLE_DOWN(void);                                            // ⎊ catch
+fern_Box fern_CIRCLED_HORIZONTAL_BAR_WITH_NOTCH(void);                                // ⎉ rank
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STAR(void);                                 // ⍟ repeat
 
 // ============================================================================================================================================================
 // internal functionallity for the primitives
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
-// catch / throw - with 'terrible setjmp/longjmp' (try ucontext later)
+// catch / throw - with setjmp/longjmp. ⎊ only sets a handler when 𝔽 may throw somewhere a failing ! cannot be seen in
+// place, see catch_recognize
 #include <setjmp.h>
 
 typedef struct fern_ExStack {
@@ -77,12 +102,181 @@ typedef struct fern_ExStack {
   jmp_buf             buf;
 } fern_ExStack;
 
-bool fern_ExStack_begin(fern_ExStack * exstack);
+// begin pushes the handler and the caller does the setjmp on `buf` itself, the frame of the setjmp has to be live when
+// fern_internal_throw jumps to it. a throw pops the handler, end pops it when nothing was thrown
+void fern_ExStack_begin(fern_ExStack * exstack);
 void fern_ExStack_end(fern_ExStack * exstack);
 
 void fern_internal_throw(fern_Box message);
 
+// the tops of the VM value stack and of the envs owned by runs of blocks. a throw out of a block jumps over the returns of
+// the runs in between, so ⎊ saves these before its setjmp and restores them when it catches, which frees those envs
+typedef struct {
+  uint32_t stack_top;
+  uint32_t frames_top;
+} fern_VMState;
+
+fern_VMState fern_internal_vm_save(void);
+void fern_internal_vm_restore(fern_VMState state);
+
 fern_Box fern_internal_tofill(fern_Box x);
+// every cell of 𝕩 boxed, with the cells past the stored data written out as the fill. kernels that index the data of an array
+// directly run on this when the array is only partly stored
+void fern_internal_expand_fill(fern_ArrayReader x, fern_Data result);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// scalar primitives that have native kernels, found from the identity of the primitive
+typedef enum {
+    fern_ScalarOp_none
+  , fern_ScalarOp_add          // +
+  , fern_ScalarOp_multiply     // ×
+  , fern_ScalarOp_max          // ⌈
+  , fern_ScalarOp_min          // ⌊
+  , fern_ScalarOp_or           // ∨
+  , fern_ScalarOp_and          // ∧
+  , fern_ScalarOp_not_equal    // ≠
+  // ops from here on have no scan kernels
+  , fern_ScalarOp_subtract     // -
+  , fern_ScalarOp_divide       // ÷
+  , fern_ScalarOp_equal        // =
+} fern_ScalarOp;
+
+fern_ScalarOp fern_internal_scalar_op(fern_Box f);
+// the op of F¨ for a scalar primitive F, which is the primitive over every cell of arrays
+fern_ScalarOp fern_internal_scalar_each_op(fern_Box f);
+// whether the monad of the primitive behind op is scalar: + - × ÷ ⌈ ⌊
+bool fern_internal_scalar_monad_op(fern_ScalarOp op);
+
+// prefix scan of 𝕩 along the first axis with `stride` cells per major cell, optionally seeded with `stride` number cells
+// returns false when there is no native kernel for the format of 𝕩, so the caller can fall back to evoking 𝔽 per cell
+bool fern_internal_scan(fern_ScalarOp op, fern_DataReader x, uint32_t stride, const fern_Box * seed, fern_Data result);
+
+// op applied cell by cell to 𝕩 (and 𝕨), either side may be a single cell that is paired with every cell of the other. the
+// result is in the narrowest format holding it. returns false when a cell is not a number
+bool fern_internal_scalar_each(fern_ScalarOp op, bool monad, fern_DataReader x, fern_DataReader w, fern_Data result);
+// a composition of scalar primitives as steps over operands: the inputs, the constants, then the result of each earlier
+// step. lift_scalar has the inputs 𝕩 and 𝕨, a fused chain of applications in the VM the arrays it read
+typedef struct {
+  fern_ScalarOp op;
+  bool monad;
+  uint8_t x;
+  uint8_t w;
+} fern_ScalarStep;
+
+typedef struct {
+  uint32_t num_consts;
+  double consts[fern_CLOSURE_MAX];
+  uint32_t num_steps;
+  fern_ScalarStep steps[fern_CLOSURE_MAX];
+  uint8_t result;
+} fern_ScalarProgram;
+
+// the program applied cell by cell to at most fern_CLOSURE_MAX inputs, a single cell input paired with every cell as with
+// fern_internal_scalar_each. all steps run over one strip of cells before the next so intermediates never leave the cache.
+// only the result is full size
+bool fern_internal_scalar_fused(const fern_ScalarProgram * program, const fern_DataReader * inputs, uint32_t num_inputs, fern_Data result);
+// op applied to every pair of a cell of 𝕨 and a cell of 𝕩, rows by cell of 𝕨
+bool fern_internal_scalar_table(fern_ScalarOp op, fern_DataReader x, fern_DataReader w, fern_Data result);
+// 𝔽´ of each of the `rows` rows of `length` cells of 𝕩, the identity of op for rows of length 0
+bool fern_internal_scalar_fold(fern_ScalarOp op, fern_DataReader x, uint32_t rows, uint32_t length, fern_Data result);
+// the identity of op, which 𝔽´ gives for an empty list: 0 for + - ∨ ≠, 1 for × ÷ ∧ =, ∞ for ⌊ and ¯∞ for ⌈
+double fern_internal_scalar_identity(fern_ScalarOp op);
+// 𝕨 op (𝕨 op … 𝕩) with `count` ops, or op applied `count` times to 𝕩, on one buffer of 𝕩 that stops early once no cell
+// changes. 𝕨 is one cell or one per cell of 𝕩. ops that are associative there go through 𝕨ⁿ by repeated squaring
+bool fern_internal_scalar_repeat(fern_ScalarOp op, bool monad, fern_DataReader x, fern_DataReader w, uint64_t count, fern_Data result);
+
+fern_Format fern_internal_natural_format(uint64_t max);
+uint32_t fern_internal_format_bit_size(fern_Format format);
+
+// copy count cells from src starting at src_index into dst starting at dst_index, dst has the same format as src
+void fern_internal_copy_cells(void * dst, uint32_t dst_index, fern_DataReader src, uint32_t src_index, uint32_t count);
+
+// total order of BQN values, numbers < characters < symbols < arrays, with arrays compared cell by cell
+int fern_internal_compare(fern_Box w, fern_Box x);
+
+// sort and grade 𝕩 as a list, grades are stable permutations so equal cells keep their order in both directions
+void fern_internal_sort(fern_DataReader x, bool down, fern_Data result);
+void fern_internal_grade(fern_DataReader x, bool down, uint32_t * order);
+// grade major cells of `stride` cells each
+void fern_internal_grade_cells(fern_ArrayReader x, uint32_t stride, bool down, uint32_t * order);
+// grade of the major cells of 𝕩, in the narrowest natural format indexing them
+void fern_internal_grade_major(fern_ArrayReader x, bool down, fern_Data result);
+
+// hash consistent with fern_internal_match, 0 and ¯0 hash the same
+uint64_t fern_internal_hash(fern_Box x);
+
+// search for each cell of `x` in the list `w`, writing an index into w or w.size when not found. the strategy (lookup table,
+// linear scan or open addressing hash) is picked from the formats and sizes of w and x
+typedef enum {
+    fern_Search_index_of              // ⊐ first index
+  , fern_Search_progressive_index_of  // ⊒ each index of w is used at most once
+} fern_Search;
+
+void fern_internal_search(fern_Search search, fern_DataReader w, fern_DataReader x, uint32_t * result);
+
+// group lengths of the group indices 𝕩 in one pass, growing to the largest index. the result is malloc'd, holds at least
+// min_length groups and is zero past the last index. negative indices are dropped, cells past the stored ones count as the fill
+uint32_t * fern_internal_group_lengths(fern_ArrayReader x, uint32_t min_length, uint32_t * num_groups);
+// the indices of 𝕩 ordered by group, `offsets` starts as the group lengths and ends as the end of each group in order
+void fern_internal_group_order(fern_ArrayReader x, uint32_t * offsets, uint32_t num_groups, uint32_t * order);
+
+// 𝕨/𝕩 on major cells of `stride` cells, 𝕨 being one natural per major cell. returns the number of major cells in the result
+uint32_t fern_internal_replicate(fern_DataReader w, fern_DataReader x, uint32_t stride, fern_Data result);
+// /𝕩, the indices of 𝕩 each repeated by its value
+void fern_internal_indices(fern_DataReader x, fern_Data result);
+
+// reverse the order of the major cells of `stride` cells
+void fern_internal_reverse(fern_DataReader x, uint32_t stride, fern_Data result);
+// rotate `outer` blocks of n major cells of `stride` cells each so that major cell `amount` of each block comes first
+void fern_internal_rotate(fern_DataReader x, uint32_t outer, uint32_t n, uint32_t stride, uint32_t amount, void * dst);
+// cell i₀…iₖ of the result, in the row major order of `shape`, is cell Σ iₖ×strides[k] of 𝕩. contiguous axes are merged,
+// a unit stride axis next to the last axis goes through a cache blocked transpose
+void fern_internal_permute(fern_DataReader x, uint32_t rank, const uint32_t * shape, const uint32_t * strides, fern_Data result);
+
+// 𝕨⊏𝕩 on n major cells of `stride` cells, 𝕨 being integers. indices are checked in one pass before an unchecked gather
+// specialised on the index and cell widths
+void fern_internal_select(fern_DataReader w, fern_DataReader x, uint32_t n, uint32_t stride, fern_Data result);
+// the indices of 𝕨 into n major cells as 32 bit naturals, negative indices counting back from n. the result is malloc'd
+uint32_t * fern_internal_select_indices(fern_DataReader w, uint32_t n);
+
+// the format that holds the cells of both formats, the wider natural or boxes
+fern_Format fern_internal_unify_format(fern_Format a, fern_Format b);
+// copy all of src into dst at dst_index, widening or boxing the cells into `format`
+void fern_internal_convert_cells(void * dst, fern_Format format, uint32_t dst_index, fern_DataReader src);
+
+// `size` cells repeating the cells of 𝕩 from the start, which must not be empty
+void fern_internal_cycle(fern_DataReader x, uint32_t size, fern_Data result);
+
+// structural ⌾ may write into an array nobody else references. the VM sets fern_internal_owned to such an array around the
+// evocation of a modified assignment, and any read of the variable resets it to nil. ⌾ sets fern_internal_fresh to each
+// result that only it references, so the VM knows the variable still owns its value afterwards
+extern fern_Box fern_internal_owned;
+extern fern_Box fern_internal_fresh;
+
+// the narrowest format holding every cell of 𝕩
+fern_Format fern_internal_cell_format(fern_DataReader x);
+// write run k of `stride` cells of `values` at major cell positions[k] of dst, converting to `format` which holds them all.
+// returns false when a position given more than once was given different cells
+bool fern_internal_scatter(void * dst, fern_Format format, const uint32_t * positions, uint32_t count, uint32_t stride, fern_DataReader values);
+
+// 𝕨⍷𝕩 on row major cells of the given shapes, 𝕨 having been given leading axes of length 1 up to the rank of 𝕩. sets bit i
+// of the result when 𝕨 matches the window of 𝕩 at position i of the shape 1+(≢𝕩)-≢𝕨
+void fern_internal_find(fern_DataReader w, const uint32_t * w_shape, fern_DataReader x, const uint32_t * x_shape, uint32_t rank, fern_Data result);
+
+// `count` cells of dst from dst_index set to `fill`, which `format` must hold. a zero fill of naturals is one memset
+void fern_internal_fill_cells(void * dst, fern_Format format, uint32_t dst_index, uint32_t count, fern_Box fill);
+// fern_internal_convert_cells for the `count` cells of src from src_index, boxed cells may also be stored into any format holding them
+void fern_internal_convert_range(void * dst, fern_Format format, uint32_t dst_index, fern_DataReader src, uint32_t src_index, uint32_t count);
+// the array of `shape` whose cell i₀…iₖ is cell i₀+o₀…iₖ+oₖ of 𝕩, or `fill` where that falls outside of 𝕩. each row along the
+// last axis is one copy of the part inside of 𝕩 with the fills around it
+void fern_internal_crop(fern_DataReader x, const uint32_t * x_shape, const uint32_t * shape, const int64_t * offset, uint32_t rank, fern_Box fill, fern_Format format, fern_Data result);
+
+// give a train or an application of ∘ ○ ⊸ ⟜ its closure, nested ones flattened into it. leaves it without one when there
+// are more than fern_CLOSURE_MAX steps or constants
+void fern_internal_compile_function(fern_Function function);
+// set the kernel of an applied modifier that is an idiom such as +´ or ⊑∘⍋ as its direct entry point, returns false when it
+// is none. idioms are never flattened into closures. 𝔽⎊𝔾 gets entries without a handler when 𝔽 allows
+bool fern_internal_recognize_idiom(fern_Function function);
 
 bool fern_internal_match_shape(fern_Array x, fern_Array w);
 bool fern_internal_match_full(fern_Box x, fern_Box w);
@@ -66,26 +66,17 @@ static fern_Box fern_GroupLen_evokation0(fern_Evokation evokation, fern_Box x, f
       fern_Array xa = fern_unpack_array(x);
       fern_ArrayReader xar = fern_read_array(xa);
 
-      int64_t shape = fern_force_natural(w) - 1;
-      for(uint32_t i = 0; i < fern_array_num_cells(xar); i++) {
-        int64_t nat = fern_array_get_natural(xar, i);
-        shape = shape > nat ? shape : nat;
-      }
-      shape += 1;
+      int64_t min_length = fern_force_natural(w);
+
+      uint32_t shape;
+      uint32_t * counts = fern_internal_group_lengths(xar, min_length > 0 ? min_length : 0, &shape);
 
       union fern_Data data;
       uint32_t * nums = fern_init_data(&data, fern_Format_natural_32_bit, shape);
-      memset(nums, 0, sizeof(*nums) * shape);
-
-      for(uint32_t i = 0; i < fern_array_num_cells(xar); i++) {
-        int64_t n = fern_array_get_natural(xar, i);
-        if(n >= 0) {
-          nums[n]++;
-        }
-      }
+      memcpy(nums, counts, sizeof(*nums) * shape);
+      free(counts);
 
-      uint32_t shape_u32 = shape;
-      return fern_mk_array2(1, &shape_u32, &data, fern_DIGIT_ZERO());
+      return fern_mk_array2(1, &shape, &data, fern_DIGIT_ZERO());
     }
     fern_fatal_error("not implemented");
   } case fern_Evokation_write_to_backend:
@@ -114,27 +105,26 @@ static fern_Box fern_GroupOrd_evokation0(fern_Evokation evokation, fern_Box x, f
       fern_Array wa = fern_unpack_array(w);
       fern_ArrayReader war = fern_read_array(wa);
 
-      uint32_t * counts = malloc(sizeof(uint32_t) * fern_array_num_cells(war));
+      uint32_t num_groups = fern_array_num_cells(war);
+      uint32_t * offsets = malloc(sizeof(uint32_t) * (num_groups ? num_groups : 1));
 
       uint32_t shape = 0;
-      for(uint32_t i = 0; i < fern_array_num_cells(war); i++) {
-        counts[i] = shape;
-        shape += fern_array_get_natural(war, i);
+      if(war.cells.format == fern_Format_natural_32_bit && war.cells.size == num_groups) {
+        memcpy(offsets, war.cells.natural_32_bit, sizeof(uint32_t) * num_groups);
+        for(uint32_t i = 0; i < num_groups; i++) {
+          shape += offsets[i];
+        }
+      } else {
+        for(uint32_t i = 0; i < num_groups; i++) {
+          offsets[i] = fern_array_get_natural(war, i);
+          shape += offsets[i];
+        }
       }
 
       union fern_Data data;
-
-      uint32_t * order = fern_init_data(&data, fern_Format_natural_32_bit, shape);
-      for(uint32_t i = 0; i < fern_array_num_cells(xar); i++) {
-        int64_t nat = fern_array_get_natural(xar, i);
-        if(nat >= 0) {
-          uint32_t count = counts[nat];
-          counts[nat]++;
-          order[count] = i;
-        }
-      }
+      fern_internal_group_order(xar, offsets, num_groups, fern_init_data(&data, fern_Format_natural_32_bit, shape));
       
-      free(counts);
+      free(offsets);
       return fern_mk_array2(1, &shape, &data, fern_array_fill(xar));
     }
     fern_fatal_error("not implemented");
@@ -179,27 +169,36 @@ fern_Box fern_provide__fill_by_(void) {
 // '𝕩 +' returns itself (compound numbers do different things)
 // 'number + number' add two numbers
 // 'character + number' returns a character
+static fern_Box fern_PLUS_SIGN_monad(fern_Box x) {
+  return x;
+}
+static fern_Box fern_PLUS_SIGN_dyad(fern_Box x, fern_Box w) {
+  fern_Box r = { .number = x.number + w.number };
+  if(isnan(r.number)) {
+    if(fern_is_character(x) && fern_is_number(w)) {
+      return fern_pack_character(fern_unpack_character(x) + fern_unpack_number(w));
+    }
+    if(fern_is_number(x) && fern_is_character(w)) {
+      return fern_pack_character(fern_unpack_character(w) + fern_unpack_number(x));
+    }
+    fern_fatal_error("+: Arguments must be number + number, or character + number");
+  }
+  return r;
+}
 static fern_Box fern_PLUS_SIGN_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
-  fern_Box r = { .number = 0 };
   switch(evokation) {
   case fern_Evokation_monad:
-    return x;
+    return fern_PLUS_SIGN_monad(x);
   case fern_Evokation_dyad:
-    r.number = x.number + w.number;
-    if(isnan(r.number)) {
-      if(fern_is_character(x) && fern_is_number(w)) {
-        return fern_pack_character(fern_unpack_character(x) + fern_unpack_number(w));
-      }
-      fern_fatal_error("+: Arguments must be number + number, or character + number");
-    }
+    return fern_PLUS_SIGN_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
     fern_fatal_error("not implemented");
   }
-  return r;
+  return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_PLUS_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_PLUS_SIGN_evokation0 };
+static struct fern_Function fern_PLUS_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_PLUS_SIGN_evokation0, .monad = fern_PLUS_SIGN_monad, .dyad = fern_PLUS_SIGN_dyad };
 fern_Box fern_PLUS_SIGN(void) {
   return fern_pack_function(&fern_PLUS_SIGN_fn);
 }
@@ -209,34 +208,40 @@ fern_Box fern_PLUS_SIGN(void) {
 // 'number - number'       -> number    - subtract two numbers
 // 'character - number'    -> character - subtract 𝕨 from 𝕩
 // 'character - character' -> number    - get the offset between two codepoints
+static fern_Box fern_HYPHEN_MINUS_monad(fern_Box x) {
+  fern_Box r = { .number = -x.number };
+  if(isnan(r.number)) {
+    fern_fatal_error("-: Arguments must be a number");
+  }
+  return r;
+}
+static fern_Box fern_HYPHEN_MINUS_dyad(fern_Box x, fern_Box w) {
+  fern_Box r = { .number = w.number - x.number };
+  if(isnan(r.number)) {
+    if(fern_is_character(x) && fern_is_character(w)) {
+      return fern_pack_number((double)fern_unpack_character(w) - fern_unpack_character(x));
+    }
+    if(fern_is_character(w) && fern_is_number(x)) {
+      return fern_pack_character(fern_unpack_character(w) - fern_unpack_number(x));
+    }
+    fern_fatal_error("-: Arguments must be number - number, character - character, or character - number");
+  }
+  return r;
+}
 static fern_Box fern_HYPHEN_MINUS_evokation(fern_Evokation evokation, fern_Box x, fern_Box w) {
-  fern_Box r = { .number = 0 };
   switch(evokation) {
   case fern_Evokation_monad:
-    r.number = -x.number;
-    if(isnan(r.number)) {
-      fern_fatal_error("-: Arguments must be a number");
-    }
-    return r;
+    return fern_HYPHEN_MINUS_monad(x);
   case fern_Evokation_dyad:
-    r.number = x.number + w.number;
-    if(isnan(r.number)) {
-      if(fern_is_character(x) && fern_is_character(w)) {
-        return fern_pack_number(fern_unpack_character(x) - fern_unpack_character(w));
-      }
-      if(fern_is_character(x) && fern_is_number(w)) {
-        return fern_pack_character(fern_unpack_character(x) - fern_unpack_number(w));
-      }
-      fern_fatal_error("-: Arguments must be number - number, character - character, or character - number");
-    }
+    return fern_HYPHEN_MINUS_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
     fern_fatal_error("not implemented");
   }
-  return r;
+  return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_HYPHEN_MINUS_fn = { .type = fern_FunctionType_c, .c = fern_HYPHEN_MINUS_evokation };
+static struct fern_Function fern_HYPHEN_MINUS_fn = { .type = fern_FunctionType_c, .c = fern_HYPHEN_MINUS_evokation, .monad = fern_HYPHEN_MINUS_monad, .dyad = fern_HYPHEN_MINUS_dyad };
 fern_Box fern_HYPHEN_MINUS(void) {
   return fern_pack_function(&fern_HYPHEN_MINUS_fn);
 }
@@ -244,27 +249,33 @@ fern_Box fern_HYPHEN_MINUS(void) {
 // × ----------------------------------------------------------------------------------------------------------------------------------------------------------
 // 'number ×'        -> number - get the sign of 𝕩
 // 'number × number' -> number - multiply two numbers
+static fern_Box fern_MULTIPLICATION_SIGN_monad(fern_Box x) {
+  if(fern_is_number(x)) {
+    return fern_pack_number(copysign(fpclassify(x.number) == FP_ZERO ? 0 : 1, x.number));
+  }
+  fern_fatal_error("×: Arguments must be a number");
+}
+static fern_Box fern_MULTIPLICATION_SIGN_dyad(fern_Box x, fern_Box w) {
+  fern_Box r = { .number = x.number * w.number };
+  if(isnan(r.number)) {
+    fern_fatal_error("×: Arguments must be number × number");
+  }
+  return r;
+}
 static fern_Box fern_MULTIPLICATION_SIGN_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
-  fern_Box r = { .number = 0 };
   switch(evokation) {
   case fern_Evokation_monad:
-    if(fern_is_number(x)) {
-      return fern_pack_number(copysign(fpclassify(x.number) == FP_ZERO ? 0 : 1, x.number));
-    }
-    fern_fatal_error("×: Arguments must be a number");
+    return fern_MULTIPLICATION_SIGN_monad(x);
   case fern_Evokation_dyad:
-    r.number = x.number * w.number;
-    if(isnan(r.number)) {
-      fern_fatal_error("×: Arguments must be number × number");
-    }
+    return fern_MULTIPLICATION_SIGN_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
     fern_fatal_error("not implemented");
   }
-  return r;
+  return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_MULTIPLICATION_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_MULTIPLICATION_SIGN_evokation0 };
+static struct fern_Function fern_MULTIPLICATION_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_MULTIPLICATION_SIGN_evokation0, .monad = fern_MULTIPLICATION_SIGN_monad, .dyad = fern_MULTIPLICATION_SIGN_dyad };
 fern_Box fern_MULTIPLICATION_SIGN(void) {
   return fern_pack_function(&fern_MULTIPLICATION_SIGN_fn);
 }
@@ -272,25 +283,29 @@ fern_Box fern_MULTIPLICATION_SIGN(void) {
 // ÷ ----------------------------------------------------------------------------------------------------------------------------------------------------------
 // 'number ÷'        -> number - get the sign of 𝕩
 // 'number ÷ number' -> number - multiply two numbers
+static fern_Box fern_DIVISION_SIGN_dyad(fern_Box x, fern_Box w) {
+  if(fern_is_number(x) && fern_is_number(w)) {
+    return fern_pack_number(w.number / x.number);
+  }
+  fern_fatal_error("÷: Arguments must be number ÷ number");
+}
+static fern_Box fern_DIVISION_SIGN_monad(fern_Box x) {
+  return fern_DIVISION_SIGN_dyad(x, fern_DIGIT_ONE());
+}
 static fern_Box fern_DIVISION_SIGN_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
-  fern_Box r = { .number = 0 };
   switch(evokation) {
   case fern_Evokation_monad:
-    w = fern_DIGIT_ONE();
+    return fern_DIVISION_SIGN_monad(x);
   case fern_Evokation_dyad:
-    if(fern_is_number(x) && fern_is_number(w)) {
-      r.number = x.number / w.number;
-    } else {
-      fern_fatal_error("÷: Arguments must be number ÷ number");
-    }
+    return fern_DIVISION_SIGN_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
     fern_fatal_error("not implemented");
   }
-  return r;
+  return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_DIVISION_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_DIVISION_SIGN_evokation0 };
+static struct fern_Function fern_DIVISION_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_DIVISION_SIGN_evokation0, .monad = fern_DIVISION_SIGN_monad, .dyad = fern_DIVISION_SIGN_dyad };
 fern_Box fern_DIVISION_SIGN(void) {
   return fern_pack_function(&fern_DIVISION_SIGN_fn);
 }
@@ -300,27 +315,33 @@ fern_Box fern_DIVISION_SIGN(void) {
 // ⌊ ----------------------------------------------------------------------------------------------------------------------------------------------------------
 // 'number ⌊'        -> number - get the floor of 𝕩
 // 'number ⌊ number' -> number - the minimum of 𝕩 and 𝕨
+static fern_Box fern_LEFT_FLOOR_monad(fern_Box x) {
+  if(fern_is_number(x)) {
+    return fern_pack_number(floor(x.number));
+  }
+  fern_fatal_error("⌊: Arguments must be a number");
+}
+static fern_Box fern_LEFT_FLOOR_dyad(fern_Box x, fern_Box w) {
+  fern_Box r = { .number = fmin(x.number, w.number) };
+  if(isnan(r.number)) {
+    fern_fatal_error("⌊: Arguments must be number ⌊ number");
+  }
+  return r;
+}
 static fern_Box fern_LEFT_FLOOR_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
-  fern_Box r = { .number = 0 };
   switch(evokation) {
   case fern_Evokation_monad:
-    if(fern_is_number(x)) {
-      return fern_pack_number(floor(x.number));
-    }
-    fern_fatal_error("⌊: Arguments must be a number");
+    return fern_LEFT_FLOOR_monad(x);
   case fern_Evokation_dyad:
-    r.number = fmin(x.number, w.number);
-    if(isnan(r.number)) {
-      fern_fatal_error("⌊: Arguments must be number ⌊ number");
-    }
+    return fern_LEFT_FLOOR_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
     fern_fatal_error("not implemented");
   }
-  return r;
+  return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_LEFT_FLOOR_fn = { .type = fern_FunctionType_c, .c = fern_LEFT_FLOOR_evokation0 };
+static struct fern_Function fern_LEFT_FLOOR_fn = { .type = fern_FunctionType_c, .c = fern_LEFT_FLOOR_evokation0, .monad = fern_LEFT_FLOOR_monad, .dyad = fern_LEFT_FLOOR_dyad };
 fern_Box fern_LEFT_FLOOR(void) {
   return fern_pack_function(&fern_LEFT_FLOOR_fn);
 }
@@ -328,42 +349,146 @@ fern_Box fern_LEFT_FLOOR(void) {
 // ⌈ ----------------------------------------------------------------------------------------------------------------------------------------------------------
 // 'number ⌈'        -> number - get the floor of 𝕩
 // 'number ⌈ number' -> number - the minimum of 𝕩 and 𝕨
+static fern_Box fern_LEFT_CEILING_monad(fern_Box x) {
+  if(fern_is_number(x)) {
+    return fern_pack_number(ceil(x.number));
+  }
+  fern_fatal_error("⌈: Arguments must be a number");
+}
+static fern_Box fern_LEFT_CEILING_dyad(fern_Box x, fern_Box w) {
+  fern_Box r = { .number = fmax(x.number, w.number) };
+  if(isnan(r.number)) {
+    fern_fatal_error("⌈: Arguments must be number ⌈ number");
+  }
+  return r;
+}
 fern_Box fern_LEFT_CEILING_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
-  fern_Box r = { .number = 0 };
   switch(evokation) {
   case fern_Evokation_monad:
-    if(fern_is_number(x)) {
-      return fern_pack_number(ceil(x.number));
-    }
-    fern_fatal_error("⌈: Arguments must be a number");
+    return fern_LEFT_CEILING_monad(x);
   case fern_Evokation_dyad:
-    r.number = fmax(x.number, w.number);
-    if(isnan(r.number)) {
-      fern_fatal_error("⌈: Arguments must be number ⌊ number");
-    }
+    return fern_LEFT_CEILING_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
     fern_fatal_error("not implemented");
   }
-  return r;
+  return fern_DIGIT_ZERO();
 }
-struct fern_Function fern_LEFT_CEILING_fn = { .type = fern_FunctionType_c, .c = fern_LEFT_CEILING_evokation0 };
+struct fern_Function fern_LEFT_CEILING_fn = { .type = fern_FunctionType_c, .c = fern_LEFT_CEILING_evokation0, .monad = fern_LEFT_CEILING_monad, .dyad = fern_LEFT_CEILING_dyad };
 #define fern_LEFT_CEILING fern_pack_function(&fern_LEFT_CEILING_fn)
 
 // ∧ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'array ∧'         -> array  - 𝕩 with its major cells sorted ascending
+// 'number ∧ number' -> number - logical and of 𝕩 and 𝕨, extended to numbers as 𝕩 × 𝕨
+static fern_Box sort_major_cells(fern_Box x, bool down) {
+  if(!fern_is_array(x) || fern_array_rank(fern_read_array(fern_unpack_array(x))) == 0) {
+    fern_fatal_error(down ? "∨: Argument cannot have rank 0" : "∧: Argument cannot have rank 0");
+  }
+
+  fern_Array xa = fern_unpack_array(x);
+  fern_ArrayReader xar = fern_read_array(xa);
+
+  uint32_t l = fern_array_num_cells(xar);
+  uint32_t n = fern_array_axis_length(xar, 0);
+  uint32_t c = n ? l / n : 0;
+
+  union fern_Data cells;
+  if(c == 1 && xar.cells.size == l) {
+    fern_internal_sort(xar.cells, down, &cells);
+    return fern_mk_array(&xa->shape, &cells, fern_array_fill(xar));
+  }
+
+  // major cells are compared cell by cell, then moved as whole blocks
+  uint32_t * order = malloc(sizeof(uint32_t) * (n ? n : 1));
+  fern_internal_grade_cells(xar, c, down, order);
+  if(xar.cells.size == l) {
+    void * dst = fern_init_data(&cells, xar.cells.format, l);
+    for(uint32_t i = 0; i < n; i++) {
+      fern_internal_copy_cells(dst, i * c, xar.cells, order[i] * c, c);
+    }
+  } else {
+    fern_Box * dst = fern_init_data(&cells, fern_Format_box, l);
+    for(uint32_t i = 0; i < n; i++) {
+      for(uint32_t j = 0; j < c; j++) {
+        *dst++ = fern_array_get_cell(xar, order[i] * c + j);
+      }
+    }
+  }
+  free(order);
+
+  return fern_mk_array(&xa->shape, &cells, fern_array_fill(xar));
+}
+static fern_Box fern_LOGICAL_AND_monad(fern_Box x) {
+  return sort_major_cells(x, false);
+}
+static fern_Box fern_LOGICAL_AND_dyad(fern_Box x, fern_Box w) {
+  if(fern_is_number(x) && fern_is_number(w)) {
+    return fern_pack_number(x.number * w.number);
+  }
+  fern_fatal_error("∧: Arguments must be number ∧ number");
+}
+static fern_Box fern_LOGICAL_AND_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    return fern_LOGICAL_AND_monad(x);
+  case fern_Evokation_dyad:
+    return fern_LOGICAL_AND_dyad(x, w);
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_LOGICAL_AND_fn = { .type = fern_FunctionType_c, .c = fern_LOGICAL_AND_evokation0, .monad = fern_LOGICAL_AND_monad, .dyad = fern_LOGICAL_AND_dyad };
+fern_Box fern_LOGICAL_AND(void) {
+  return fern_pack_function(&fern_LOGICAL_AND_fn);
+}
+
 // ∨ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'array ∨'         -> array  - 𝕩 with its major cells sorted descending
+// 'number ∨ number' -> number - logical or of 𝕩 and 𝕨, extended to numbers as (𝕩 + 𝕨) - 𝕩 × 𝕨
+static fern_Box fern_LOGICAL_OR_monad(fern_Box x) {
+  return sort_major_cells(x, true);
+}
+static fern_Box fern_LOGICAL_OR_dyad(fern_Box x, fern_Box w) {
+  if(fern_is_number(x) && fern_is_number(w)) {
+    return fern_pack_number((x.number + w.number) - x.number * w.number);
+  }
+  fern_fatal_error("∨: Arguments must be number ∨ number");
+}
+static fern_Box fern_LOGICAL_OR_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    return fern_LOGICAL_OR_monad(x);
+  case fern_Evokation_dyad:
+    return fern_LOGICAL_OR_dyad(x, w);
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_LOGICAL_OR_fn = { .type = fern_FunctionType_c, .c = fern_LOGICAL_OR_evokation0, .monad = fern_LOGICAL_OR_monad, .dyad = fern_LOGICAL_OR_dyad };
+fern_Box fern_LOGICAL_OR(void) {
+  return fern_pack_function(&fern_LOGICAL_OR_fn);
+}
+
 // ¬ ----------------------------------------------------------------------------------------------------------------------------------------------------------
 // | ----------------------------------------------------------------------------------------------------------------------------------------------------------
 // 'number |' -> number - get the absolute value
+static fern_Box fern_VERTICAL_LINE_monad(fern_Box x) {
+  if(fern_is_number(x)) {
+    return fern_pack_number(abs(x.number));
+  }
+  fern_fatal_error("⌈: Arguments must be a number");
+}
 static fern_Box fern_VERTICAL_LINE_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
-  fern_Box r = { .number = 0 };
   switch(evokation) {
   case fern_Evokation_monad:
-    if(fern_is_number(x)) {
-      return fern_pack_number(abs(x.number));
-    }
-    fern_fatal_error("⌈: Arguments must be a number");
+    return fern_VERTICAL_LINE_monad(x);
   case fern_Evokation_dyad:
     fern_fatal_error("not implemented");
   case fern_Evokation_write_to_backend:
@@ -371,9 +496,9 @@ static fern_Box fern_VERTICAL_LINE_evokation0(fern_Evokation evokation, fern_Box
   case fern_Evokation_inverse:
     fern_fatal_error("not implemented");
   }
-  return r;
+  return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_VERTICAL_LINE_fn = { .type = fern_FunctionType_c, .c = fern_VERTICAL_LINE_evokation0 };
+static struct fern_Function fern_VERTICAL_LINE_fn = { .type = fern_FunctionType_c, .c = fern_VERTICAL_LINE_evokation0, .monad = fern_VERTICAL_LINE_monad };
 fern_Box fern_VERTICAL_LINE(void) {
   return fern_pack_function(&fern_VERTICAL_LINE_fn);
 }
@@ -410,12 +535,15 @@ static inline double lesseq(fern_Box x, fern_Box w) {
   }
   return x_rank <= w_rank;
 }
+static fern_Box fern_LESS_THAN_OR_EQUAL_TO_dyad(fern_Box x, fern_Box w) {
+  return fern_pack_number(lesseq(x, w));
+}
 static fern_Box fern_LESS_THAN_OR_EQUAL_TO_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
     fern_fatal_error("not implemented");
   case fern_Evokation_dyad:
-    return fern_pack_number(lesseq(x, w));
+    return fern_LESS_THAN_OR_EQUAL_TO_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -423,22 +551,26 @@ static fern_Box fern_LESS_THAN_OR_EQUAL_TO_evokation0(fern_Evokation evokation,
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_LESS_THAN_OR_EQUAL_TO_fn = { .type = fern_FunctionType_c, .c = fern_LESS_THAN_OR_EQUAL_TO_evokation0 };
+static struct fern_Function fern_LESS_THAN_OR_EQUAL_TO_fn = { .type = fern_FunctionType_c, .c = fern_LESS_THAN_OR_EQUAL_TO_evokation0, .dyad = fern_LESS_THAN_OR_EQUAL_TO_dyad };
 fern_Box fern_LESS_THAN_OR_EQUAL_TO(void) {
   return fern_pack_function(&fern_LESS_THAN_OR_EQUAL_TO_fn);
 }
 
 // < ----------------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_LESS_THAN_SIGN_monad(fern_Box x) {
+  fern_Array array = fern_allocate_array();
+  fern_init_array_singleton(array, x, fern_internal_tofill(x));
+  return fern_pack_array(array);
+}
+static fern_Box fern_LESS_THAN_SIGN_dyad(fern_Box x, fern_Box w) {
+  return fern_pack_number(1 - lesseq(x, w));
+}
 static fern_Box fern_LESS_THAN_SIGN_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
-    {
-      fern_Array array = fern_allocate_array();
-      fern_init_array_singleton(array, x, fern_internal_tofill(x));
-      return fern_pack_array(array);
-    }
+    return fern_LESS_THAN_SIGN_monad(x);
   case fern_Evokation_dyad:
-    return fern_pack_number(1 - lesseq(x, w));
+    return fern_LESS_THAN_SIGN_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -446,18 +578,21 @@ static fern_Box fern_LESS_THAN_SIGN_evokation0(fern_Evokation evokation, fern_Bo
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_LESS_THAN_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_LESS_THAN_SIGN_evokation0 };
+static struct fern_Function fern_LESS_THAN_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_LESS_THAN_SIGN_evokation0, .monad = fern_LESS_THAN_SIGN_monad, .dyad = fern_LESS_THAN_SIGN_dyad };
 fern_Box fern_LESS_THAN_SIGN(void) {
   return fern_pack_function(&fern_LESS_THAN_SIGN_fn);
 }
 
 // > ----------------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_GREATER_THAN_SIGN_dyad(fern_Box x, fern_Box w) {
+  return fern_pack_number(1 - lesseq(w, x));
+}
 static fern_Box fern_GREATER_THAN_SIGN_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
     fern_fatal_error("not implemented");
   case fern_Evokation_dyad:
-    return fern_pack_number(1 - lesseq(w, x));
+    return fern_GREATER_THAN_SIGN_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -465,18 +600,21 @@ static fern_Box fern_GREATER_THAN_SIGN_evokation0(fern_Evokation evokation, fern
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_GREATER_THAN_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_GREATER_THAN_SIGN_evokation0 };
+static struct fern_Function fern_GREATER_THAN_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_GREATER_THAN_SIGN_evokation0, .dyad = fern_GREATER_THAN_SIGN_dyad };
 fern_Box fern_GREATER_THAN_SIGN(void) {
   return fern_pack_function(&fern_GREATER_THAN_SIGN_fn);
 }
 
 // ≥ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_GREATER_THAN_OR_EQUAL_TO_dyad(fern_Box x, fern_Box w) {
+  return fern_pack_number(lesseq(w, x));
+}
 static fern_Box fern_GREATER_THAN_OR_EQUAL_TO_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
     fern_fatal_error("not implemented");
   case fern_Evokation_dyad:
-    return fern_pack_number(lesseq(w, x));
+    return fern_GREATER_THAN_OR_EQUAL_TO_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -484,7 +622,7 @@ static fern_Box fern_GREATER_THAN_OR_EQUAL_TO_evokation0(fern_Evokation evokatio
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_GREATER_THAN_OR_EQUAL_TO_fn = { .type = fern_FunctionType_c, .c = fern_GREATER_THAN_OR_EQUAL_TO_evokation0 };
+static struct fern_Function fern_GREATER_THAN_OR_EQUAL_TO_fn = { .type = fern_FunctionType_c, .c = fern_GREATER_THAN_OR_EQUAL_TO_evokation0, .dyad = fern_GREATER_THAN_OR_EQUAL_TO_dyad };
 fern_Box fern_GREATER_THAN_OR_EQUAL_TO(void) {
   return fern_pack_function(&fern_GREATER_THAN_OR_EQUAL_TO_fn);
 }
@@ -494,23 +632,29 @@ fern_Box fern_GREATER_THAN_OR_EQUAL_TO(void) {
 // 'number = number'       -> number - 1 if 𝕩 and 𝕨 are equal, 0 otherwise
 // 'character = character' -> number - 1 if 𝕩 and 𝕨 are equal, 0 otherwise
 // 'symbol = symbol'       -> number - 1 if 𝕩 and 𝕨 are equal, 0 otherwise
+static fern_Box fern_EQUAL_SIGN_monad(fern_Box x) {
+  if(fern_is_array(x)) {
+    return fern_pack_number(
+      fern_array_rank(fern_read_array(fern_unpack_array(x)))
+    );
+  }
+  fern_fatal_error("=: Argument must be a number");
+}
+static fern_Box fern_EQUAL_SIGN_dyad(fern_Box x, fern_Box w) {
+  if(fern_is_number(x) && fern_is_number(w)) {
+    return fern_pack_number(x.number == w.number);
+  }
+  if(fern_is_character(x) && fern_is_character(w)) {
+    return fern_pack_number(x.number == w.number);
+  }
+  fern_fatal_error("=: Arguments must be number = number, or character = character");
+}
 static fern_Box fern_EQUAL_SIGN_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
-    if(fern_is_array(x)) {
-      return fern_pack_number(
-        fern_array_rank(fern_read_array(fern_unpack_array(x)))
-      );
-    }
-    fern_fatal_error("=: Argument must be a number");
+    return fern_EQUAL_SIGN_monad(x);
   case fern_Evokation_dyad:
-    if(fern_is_number(x) && fern_is_number(w)) {
-      return fern_pack_number(x.number == w.number);
-    }
-    if(fern_is_character(x) && fern_is_character(w)) {
-      return fern_pack_number(x.number == w.number);
-    }
-    fern_fatal_error("=: Arguments must be number = number, or character = character");
+    return fern_EQUAL_SIGN_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -518,22 +662,39 @@ static fern_Box fern_EQUAL_SIGN_evokation0(fern_Evokation evokation, fern_Box x,
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_EQUAL_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_EQUAL_SIGN_evokation0 };
+static struct fern_Function fern_EQUAL_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_EQUAL_SIGN_evokation0, .monad = fern_EQUAL_SIGN_monad, .dyad = fern_EQUAL_SIGN_dyad };
 fern_Box fern_EQUAL_SIGN(void) {
   return fern_pack_function(&fern_EQUAL_SIGN_fn);
 }
 
 // ≠ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'array ≠'     -> number - the length of the first axis of 𝕩
+// 'any ≠'       -> number - 1
+// 'atom ≠ atom' -> number - 1 if 𝕩 and 𝕨 are not equal, 0 otherwise
+// 'any ≠ any'   -> array  - pervasive, ≠ of matching cells as with ≠¨
+static fern_Box fern_DIAERESIS_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w);
+static fern_Box fern_NOT_EQUAL_SIGN_monad(fern_Box x) {
+  if(fern_is_array(x)) {
+    fern_Array xa = fern_unpack_array(x);
+    return fern_pack_number(fern_array_axis_length(fern_read_array(xa), 0));
+  }
+  return fern_DIGIT_ONE();
+}
+static fern_Box fern_NOT_EQUAL_SIGN_dyad(fern_Box x, fern_Box w) {
+  if(fern_is_number(x) && fern_is_number(w)) {
+    return fern_pack_number(x.number != w.number);
+  }
+  if(fern_is_array(x) || fern_is_array(w)) {
+    return fern_DIAERESIS_evokation0(fern_Evokation_dyad, fern_NOT_EQUAL_SIGN(), x, w);
+  }
+  return fern_pack_number(!fern_internal_match(x, w));
+}
 static fern_Box fern_NOT_EQUAL_SIGN_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
+    return fern_NOT_EQUAL_SIGN_monad(x);
   case fern_Evokation_dyad:
-    if(fern_is_array(x)) {
-      fern_Array xa = fern_unpack_array(x);
-      return fern_pack_number(fern_array_axis_length(fern_read_array(xa), 0));
-    } else {
-      return fern_DIGIT_ONE();
-    }
+    return fern_NOT_EQUAL_SIGN_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -541,7 +702,7 @@ static fern_Box fern_NOT_EQUAL_SIGN_evokation0(fern_Evokation evokation, fern_Bo
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_NOT_EQUAL_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_NOT_EQUAL_SIGN_evokation0 };
+static struct fern_Function fern_NOT_EQUAL_SIGN_fn = { .type = fern_FunctionType_c, .c = fern_NOT_EQUAL_SIGN_evokation0, .monad = fern_NOT_EQUAL_SIGN_monad, .dyad = fern_NOT_EQUAL_SIGN_dyad };
 fern_Box fern_NOT_EQUAL_SIGN(void) {
   return fern_pack_function(&fern_NOT_EQUAL_SIGN_fn);
 }
@@ -583,12 +744,18 @@ fern_Box fern_NOT_IDENTICAL_TO(void) {
 }
 
 // ⊣ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_LEFT_TACK_monad(fern_Box x) {
+  return x;
+}
+static fern_Box fern_LEFT_TACK_dyad(fern_Box x, fern_Box w) {
+  return w;
+}
 static fern_Box fern_LEFT_TACK_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
-    return x;
+    return fern_LEFT_TACK_monad(x);
   case fern_Evokation_dyad:
-    return w;
+    return fern_LEFT_TACK_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -596,17 +763,24 @@ static fern_Box fern_LEFT_TACK_evokation0(fern_Evokation evokation, fern_Box x,
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_LEFT_TACK_fn = { .type = fern_FunctionType_c, .c = fern_LEFT_TACK_evokation0 };
+static struct fern_Function fern_LEFT_TACK_fn = { .type = fern_FunctionType_c, .c = fern_LEFT_TACK_evokation0, .monad = fern_LEFT_TACK_monad, .dyad = fern_LEFT_TACK_dyad };
 fern_Box fern_LEFT_TACK(void) {
   return fern_pack_function(&fern_LEFT_TACK_fn);
 }
 
 // ⊢ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_RIGHT_TACK_monad(fern_Box x) {
+  return x;
+}
+static fern_Box fern_RIGHT_TACK_dyad(fern_Box x, fern_Box w) {
+  return x;
+}
 static fern_Box fern_RIGHT_TACK_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
+    return fern_RIGHT_TACK_monad(x);
   case fern_Evokation_dyad:
-    return x;
+    return fern_RIGHT_TACK_dyad(x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -614,41 +788,77 @@ static fern_Box fern_RIGHT_TACK_evokation0(fern_Evokation evokation, fern_Box x,
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_RIGHT_TACK_fn = { .type = fern_FunctionType_c, .c = fern_RIGHT_TACK_evokation0 };
+static struct fern_Function fern_RIGHT_TACK_fn = { .type = fern_FunctionType_c, .c = fern_RIGHT_TACK_evokation0, .monad = fern_RIGHT_TACK_monad, .dyad = fern_RIGHT_TACK_dyad };
 fern_Box fern_RIGHT_TACK(void) {
   return fern_pack_function(&fern_RIGHT_TACK_fn);
 }
 
 // ⥊ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// 'array ⥊'       -> array - 𝕩 array without shape
-// 'array ⥊ array' -> array - 𝕩 with shape defined by 𝕨, 𝕨 being a 1d array of natural numbers
+// 'array ⥊'         -> list  - the cells of 𝕩 as a list, sharing them with 𝕩
+// 'natural ⥊ any'   -> list  - 𝕨 ⥊ with a shape of one axis
+// 'list ⥊ any'      -> array - the cells of 𝕩 with shape 𝕨, cycled when 𝕨 needs more cells and a shared prefix when it needs fewer
 static fern_Box fern_LEFT_BARB_UP_RIGHT_BARB_DOWN_HARPOON_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
   if(evokation == fern_Evokation_write_to_backend || evokation == fern_Evokation_inverse) {
     fern_fatal_error("not implemented");
   }
 
-  fern_Array xa = fern_unpack_array(x);
-  fern_ArrayReader xar = fern_read_array(xa);
+  // an atom 𝕩 is a single boxed cell
+  union fern_Data atom;
+  if(!fern_is_array(x)) {
+    *(fern_Box *)fern_init_data(&atom, fern_Format_box, 1) = x;
+  }
+  fern_Data cells = fern_is_array(x) ? &fern_unpack_array(x)->cells : &atom;
+  fern_DataReader cells_reader = fern_read_data(cells);
+  fern_Box fill = fern_is_array(x) ? fern_array_fill(fern_read_array(fern_unpack_array(x))) : fern_internal_tofill(x);
+
+  uint32_t num_cells = fern_is_array(x) ? fern_array_num_cells(fern_read_array(fern_unpack_array(x))) : 1;
 
   uint32_t rank = 1;
-  uint32_t linear_shape;
+  uint32_t linear_shape = num_cells;
   uint32_t * shape = &linear_shape;
 
   if(evokation == fern_Evokation_dyad) {
-    fern_Array wa = fern_unpack_array(w);
-    fern_ArrayReader war = fern_read_array(wa);
-    
-    rank = fern_array_num_cells(war);
-    shape = malloc(sizeof(uint32_t) * rank);
-
-    for(uint32_t i = 0; i < rank; i++) {
-      shape[i] = fern_array_get_natural(war, i);
+    if(fern_is_array(w)) {
+      fern_ArrayReader war = fern_read_array(fern_unpack_array(w));
+      fern_assert_fatal_error(fern_array_rank(war) <= 1, "⥊: 𝕨 must have rank at most 1");
+      rank = fern_array_num_cells(war);
+      shape = malloc(sizeof(uint32_t) * (rank ? rank : 1));
+      for(uint32_t i = 0; i < rank; i++) {
+        int64_t length = fern_array_get_natural(war, i);
+        fern_assert_fatal_error(length >= 0, "⥊: 𝕨 must consist of natural numbers");
+        shape[i] = length;
+      }
+    } else {
+      int64_t length = fern_force_natural(w);
+      fern_assert_fatal_error(length >= 0, "⥊: 𝕨 must consist of natural numbers");
+      linear_shape = length;
     }
+  }
+
+  uint64_t size = 1;
+  for(uint32_t i = 0; i < rank; i++) {
+    size *= shape[i];
+  }
+  fern_assert_fatal_error(size <= UINT32_MAX, "⥊: result too large");
+
+  // a prefix of 𝕩 keeps the cells that read as the fill, only cycling past the end of 𝕩 writes them out
+  union fern_Data data;
+  if(size <= num_cells) {
+    fern_slice_data(&data, cells, 0, size < cells_reader.size ? size : cells_reader.size);
   } else {
-    *shape = fern_array_num_cells(xar);
+    fern_assert_fatal_error(num_cells > 0, "⥊: Can't produce non-empty array from empty 𝕩");
+    union fern_Data full;
+    if(cells_reader.size < num_cells) {
+      fern_internal_expand_fill(fern_read_array(fern_unpack_array(x)), &full);
+    }
+    fern_internal_cycle(cells_reader.size < num_cells ? fern_read_data(&full) : cells_reader, size, &data);
+    if(cells_reader.size < num_cells) {
+      fern_free_data(&full);
+    }
   }
 
-  fern_Box result = fern_mk_array2(1, shape, &xa->cells, fern_array_fill(xar));
+  fern_Box result = fern_mk_array2(rank, shape, &data, fill);
+  fern_free_data(&data);
 
   if(shape != &linear_shape) {
     free(shape);
@@ -662,30 +872,139 @@ fern_Box fern_LEFT_BARB_UP_RIGHT_BARB_DOWN_HARPOON(void) {
 }
 
 // ∾ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// the parts laid end to end along a new first axis, or along the first axis of the highest rank part when joining. the
+// length and the unified format are found first, so the result is allocated once and each part is copied straight into it
+static fern_Box concatenate_parts(uint32_t count, const fern_Box * parts, bool couple, const char * error) {
+  if(count == 0) {
+    return fern_EMPTY_ARRAY();
+  }
 
-// ≍ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// ⋈ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// ↑ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// ↓ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// ↕ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// 'natural ↕' -> 1d array - make an array of natural numbers from 0 to 𝕩
-static fern_Box fern_UP_DOWN_ARROW_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  uint32_t rank = 0;
+  fern_Format format = fern_Format_LAST;
+  fern_Box fill = fern_DIGIT_ZERO();
+  bool has_fill = false;
+  for(uint32_t i = 0; i < count; i++) {
+    fern_Format part_format = fern_Format_box;
+    uint32_t part_rank = 0;
+    if(fern_is_array(parts[i])) {
+      fern_ArrayReader par = fern_read_array(fern_unpack_array(parts[i]));
+      part_format = fern_array_complete(par) ? par.cells.format : fern_Format_box;
+      part_rank = fern_array_rank(par);
+      if(!has_fill) {
+        fill = fern_array_fill(par);
+        has_fill = true;
+      }
+    } else if(fern_is_character(parts[i])) {
+      part_format = fern_Format_character;
+    }
+    format = format == fern_Format_LAST ? part_format : fern_internal_unify_format(format, part_format);
+    rank = part_rank > rank ? part_rank : rank;
+  }
+  if(!has_fill) {
+    fill = fern_internal_tofill(parts[0]);
+  }
+
+  // every part contributes whole major cells of the same shape, `first` is the part the cell shape is read from
+  uint32_t cell_rank = couple ? rank : (rank ? rank - 1 : 0);
+  uint32_t first = 0;
+  for(uint32_t i = 0; i < count; i++) {
+    if(fern_is_array(parts[i]) && fern_array_rank(fern_read_array(fern_unpack_array(parts[i]))) == rank) {
+      first = i;
+      break;
+    }
+  }
+  fern_ArrayReader first_reader = fern_read_array(fern_unpack_array(fern_is_array(parts[first]) ? parts[first] : fern_EMPTY_ARRAY()));
+  uint32_t first_skip = fern_is_array(parts[first]) && !couple && rank == fern_array_rank(first_reader) && rank > 0;
+
+  uint64_t num_major = 0;
+  uint64_t size = 0;
+  for(uint32_t i = 0; i < count; i++) {
+    fern_ArrayReader par = fern_is_array(parts[i]) ? fern_read_array(fern_unpack_array(parts[i])) : first_reader;
+    uint32_t part_rank = fern_is_array(parts[i]) ? fern_array_rank(par) : 0;
+    uint32_t part_size = fern_is_array(parts[i]) ? fern_array_num_cells(par) : 1;
+    uint32_t skip = part_rank > cell_rank;
+    fern_assert_fatal_error(part_rank == cell_rank || part_rank == cell_rank + 1, error);
+    for(uint32_t k = 0; k < cell_rank; k++) {
+      fern_assert_fatal_error(fern_array_axis_length(par, k + skip) == fern_array_axis_length(first_reader, k + first_skip), error);
+    }
+    num_major += skip ? fern_array_axis_length(par, 0) : 1;
+    size += part_size;
+  }
+  fern_assert_fatal_error(size <= UINT32_MAX, "∾: result too large");
+
+  union fern_Data data;
+  void * dst = fern_init_data(&data, format, size);
+  uint32_t offset = 0;
+  for(uint32_t i = 0; i < count; i++) {
+    // a partly stored part was given the box format above, its cells read as the fill are written out here
+    union fern_Data full;
+    bool expand = fern_is_array(parts[i]) && !fern_array_complete(fern_read_array(fern_unpack_array(parts[i])));
+    if(expand) {
+      fern_internal_expand_fill(fern_read_array(fern_unpack_array(parts[i])), &full);
+    }
+    uint32_t character = fern_is_character(parts[i]) ? fern_unpack_character(parts[i]) : 0;
+    fern_DataReader src = expand
+      ? fern_read_data(&full)
+      : fern_is_array(parts[i])
+      ? fern_read_array(fern_unpack_array(parts[i])).cells
+      : fern_is_character(parts[i])
+      ? (fern_DataReader) { .format = fern_Format_character, .size = 1, .character = &character }
+      : (fern_DataReader) { .format = fern_Format_box, .size = 1, .box = &parts[i] };
+    fern_internal_convert_cells(dst, format, offset, src);
+    offset += src.size;
+    if(expand) {
+      fern_free_data(&full);
+    }
+  }
+
+  uint32_t * shape = malloc(sizeof(uint32_t) * (cell_rank + 1));
+  shape[0] = num_major;
+  for(uint32_t k = 0; k < cell_rank; k++) {
+    shape[k + 1] = fern_array_axis_length(first_reader, k + first_skip);
+  }
+  union fern_Data shape_data;
+  fern_init_shape(&shape_data, cell_rank + 1, shape);
+  free(shape);
+
+  fern_Box result = fern_mk_array(&shape_data, &data, fill);
+  fern_free_data(&shape_data);
+  return result;
+}
+
+// 'list ∾'        -> array - the arrays in 𝕩 joined along their first axis
+// 'any ∾ any'     -> array - 𝕨 and 𝕩 joined along the first axis, a part of lower rank is a single major cell
+static fern_Box fern_INVERTED_LAZY_S_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
     {
-      uint32_t shape = fern_force_natural(x);
-
-      union fern_Data data;
-      uint32_t * nums = fern_init_data(&data, fern_Format_natural_32_bit, shape);
-
-      for(uint32_t i = 0; i < shape; i++) {
-        nums[i] = i;
+      if(!fern_is_array(x) || fern_array_rank(fern_read_array(fern_unpack_array(x))) != 1) {
+        fern_fatal_error("∾: 𝕩 must be a list");
       }
-
-      return fern_mk_array2(1, &shape, &data, fern_DIGIT_ZERO());
+      fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+      uint32_t n = fern_array_num_cells(xar);
+      if(n == 0) {
+        return fern_EMPTY_ARRAY();
+      }
+      union fern_Data full;
+      if(!fern_array_complete(xar)) {
+        fern_internal_expand_fill(xar, &full);
+      }
+      fern_DataReader cells = fern_array_complete(xar) ? xar.cells : fern_read_data(&full);
+      fern_assert_fatal_error(cells.format == fern_Format_box, "∾: 𝕩 must be a list of arrays");
+      for(uint32_t i = 0; i < n; i++) {
+        fern_assert_fatal_error(fern_is_array(cells.box[i]), "∾: 𝕩 must be a list of arrays");
+      }
+      fern_Box result = concatenate_parts(n, cells.box, false, "∾: Element shapes must agree");
+      if(!fern_array_complete(xar)) {
+        fern_free_data(&full);
+      }
+      return result;
     }
   case fern_Evokation_dyad:
-    fern_fatal_error("not implemented");
+    {
+      fern_Box parts[2] = { w, x };
+      return concatenate_parts(2, parts, false, "∾: Ranks of 𝕨 and 𝕩 must differ by at most 1 and their cell shapes must agree");
+    }
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -693,30 +1012,799 @@ static fern_Box fern_UP_DOWN_ARROW_evokation0(fern_Evokation evokation, fern_Box
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Function fern_UP_DOWN_ARROW_fn = { .type = fern_FunctionType_c, .c = fern_UP_DOWN_ARROW_evokation0 };
-fern_Box fern_UP_DOWN_ARROW(void) {
-  return fern_pack_function(&fern_UP_DOWN_ARROW_fn);
+static struct fern_Function fern_INVERTED_LAZY_S_fn = { .type = fern_FunctionType_c, .c = fern_INVERTED_LAZY_S_evokation0 };
+fern_Box fern_INVERTED_LAZY_S(void) {
+  return fern_pack_function(&fern_INVERTED_LAZY_S_fn);
 }
 
-// « ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// » ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// ⌽ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// ⍉ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// / ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// ⍋ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// ⍒ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// ⊏ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// ⊑ ----------------------------------------------------------------------------------------------------------------------------------------------------------
-// 'array ⊑ natural' -> any - get the first item from 𝕩, index is 𝕨
-static fern_Box fern_SQUARE_IMAGE_OF_OR_EQUAL_TO_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+// ≍ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'any ≍'         -> array - 𝕩 with a leading axis of length 1, sharing the cells of 𝕩
+// 'any ≍ any'     -> array - 𝕨 and 𝕩 as the two major cells of the result
+static fern_Box fern_EQUIVALENT_TO_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
-    fern_fatal_error("not implemented");
-  case fern_Evokation_dyad:
     {
+      if(!fern_is_array(x)) {
+        return concatenate_parts(1, &x, true, "≍: unreachable");
+      }
       fern_Array xa = fern_unpack_array(x);
       fern_ArrayReader xar = fern_read_array(xa);
-      return fern_array_get_cell(xar, fern_force_natural(w));
+      uint32_t rank = fern_array_rank(xar);
+
+      uint32_t * shape = malloc(sizeof(uint32_t) * (rank + 1));
+      shape[0] = 1;
+      for(uint32_t k = 0; k < rank; k++) {
+        shape[k + 1] = fern_array_axis_length(xar, k);
+      }
+      union fern_Data shape_data;
+      fern_init_shape(&shape_data, rank + 1, shape);
+      free(shape);
+
+      fern_Box result = fern_mk_array(&shape_data, &xa->cells, fern_array_fill(xar));
+      fern_free_data(&shape_data);
+      return result;
+    }
+  case fern_Evokation_dyad:
+    {
+      fern_Box parts[2] = { w, x };
+      uint32_t w_rank = fern_is_array(w) ? fern_array_rank(fern_read_array(fern_unpack_array(w))) : 0;
+      uint32_t x_rank = fern_is_array(x) ? fern_array_rank(fern_read_array(fern_unpack_array(x))) : 0;
+      fern_assert_fatal_error(w_rank == x_rank, "≍: 𝕨 and 𝕩 must have the same shape");
+      return concatenate_parts(2, parts, true, "≍: 𝕨 and 𝕩 must have the same shape");
+    }
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_EQUIVALENT_TO_fn = { .type = fern_FunctionType_c, .c = fern_EQUIVALENT_TO_evokation0 };
+fern_Box fern_EQUIVALENT_TO(void) {
+  return fern_pack_function(&fern_EQUIVALENT_TO_fn);
+}
+
+// ⋈ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// ↑ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'integer | list ↑ any' and 'integer | list ↓ any' as one call, 𝕩 gets leading axes of length 1 when 𝕨 is longer than its rank.
+// a slice of the first axis inside of 𝕩 shares the cells of 𝕩, anything else is cropped into a new array padded with the fill
+static fern_Box take_drop(fern_Box x, fern_Box w, bool drop) {
+  const char * error = drop ? "↓: 𝕨 must consist of integers" : "↑: 𝕨 must consist of integers";
+  union fern_Data w_atom;
+  if(fern_is_array(w)) {
+    fern_ArrayReader war = fern_read_array(fern_unpack_array(w));
+    fern_assert_fatal_error(fern_array_rank(war) <= 1, drop ? "↓: 𝕨 must have rank at most 1" : "↑: 𝕨 must have rank at most 1");
+  } else {
+    *(fern_Box *)fern_init_data(&w_atom, fern_Format_box, 1) = w;
+  }
+  fern_ArrayReader war = fern_read_array(fern_is_array(w) ? fern_unpack_array(w) : NULL);
+  bool w_full = !fern_is_array(w) || fern_array_complete(war);
+  if(!w_full) {
+    fern_internal_expand_fill(war, &w_atom);
+  }
+  fern_DataReader amounts = fern_read_data(w_full && fern_is_array(w) ? &fern_unpack_array(w)->cells : &w_atom);
+
+  // an atom 𝕩 is a single boxed cell
+  union fern_Data atom;
+  if(!fern_is_array(x)) {
+    *(fern_Box *)fern_init_data(&atom, fern_Format_box, 1) = x;
+  }
+  fern_Data cells = fern_is_array(x) ? &fern_unpack_array(x)->cells : &atom;
+  fern_ArrayReader xar = fern_is_array(x) ? fern_read_array(fern_unpack_array(x)) : (fern_ArrayReader){ 0 };
+  fern_Box fill = fern_is_array(x) ? fern_array_fill(xar) : fern_internal_tofill(x);
+  uint32_t x_rank = fern_is_array(x) ? fern_array_rank(xar) : 0;
+  uint32_t rank = amounts.size > x_rank ? amounts.size : x_rank;
+  uint32_t extra = rank - x_rank;
+  if(rank == 0) {
+    return x;
+  }
+
+  uint32_t * x_shape = malloc(sizeof(uint32_t) * rank * 2);
+  uint32_t * shape = x_shape + rank;
+  int64_t * offset = malloc(sizeof(int64_t) * rank);
+  bool padded = false;
+  for(uint32_t k = 0; k < rank; k++) {
+    x_shape[k] = k < extra ? 1 : fern_array_axis_length(xar, k - extra);
+    shape[k] = x_shape[k];
+    offset[k] = 0;
+    if(k >= amounts.size) {
+      continue;
+    }
+    fern_Box amount = fern_data_get_cell(amounts, k);
+    fern_assert_fatal_error(fern_is_number(amount) && round(amount.number) == amount.number, error);
+    double a = amount.number;
+    double length = fabs(a);
+    if(drop) {
+      shape[k] = length >= x_shape[k] ? 0 : x_shape[k] - (uint32_t)length;
+      offset[k] = a > 0 ? x_shape[k] - shape[k] : 0;
+    } else {
+      fern_assert_fatal_error(length <= UINT32_MAX, "↑: result too large");
+      shape[k] = length;
+      offset[k] = a >= 0 ? 0 : (int64_t)x_shape[k] - shape[k];
+      padded |= offset[k] < 0 || offset[k] + shape[k] > x_shape[k];
+    }
+  }
+
+  bool view = extra == 0 && !padded && xar.cells.size == fern_array_num_cells(xar);
+  for(uint32_t k = 1; k < rank; k++) {
+    view &= shape[k] == x_shape[k];
+  }
+
+  union fern_Data data;
+  if(view) {
+    uint32_t stride = x_shape[0] ? xar.cells.size / x_shape[0] : 0;
+    fern_slice_data(&data, cells, offset[0] * stride, shape[0] * stride);
+  } else {
+    // cells past the data of 𝕩 read as the fill as well
+    fern_DataReader reader = fern_read_data(cells);
+    fern_Format format = reader.format;
+    if(padded || reader.size < fern_array_num_cells(xar)) {
+      union fern_Data fill_data;
+      *(fern_Box *)fern_init_data(&fill_data, fern_Format_box, 1) = fill;
+      format = fern_internal_unify_format(format, fern_internal_cell_format(fern_read_data(&fill_data)));
+    }
+    fern_internal_crop(reader, x_shape, shape, offset, rank, fill, format, &data);
+  }
+
+  fern_Box result = fern_mk_array2(rank, shape, &data, fill);
+  fern_free_data(&data);
+  if(!w_full) {
+    fern_free_data(&w_atom);
+  }
+  free(offset);
+  free(x_shape);
+  return result;
+}
+
+// the prefixes or suffixes of 𝕩 as a list of 1 + ≠𝕩 arrays, each sharing the cells of 𝕩
+static fern_Box affixes(fern_Box x, bool suffixes) {
+  if(!fern_is_array(x) || fern_array_rank(fern_read_array(fern_unpack_array(x))) == 0) {
+    fern_fatal_error(suffixes ? "↓: 𝕩 must have rank at least 1" : "↑: 𝕩 must have rank at least 1");
+  }
+  uint32_t n = fern_array_axis_length(fern_read_array(fern_unpack_array(x)), 0);
+  uint32_t size = n + 1;
+  union fern_Data data;
+  fern_Box * parts = fern_init_data(&data, fern_Format_box, size);
+  for(uint32_t i = 0; i <= n; i++) {
+    parts[i] = take_drop(x, fern_pack_number(i), suffixes);
+  }
+  fern_Box result = fern_mk_array2(1, &size, &data, fern_DIGIT_ZERO());
+  fern_free_data(&data);
+  return result;
+}
+
+// 'array ↑'       -> list  - the prefixes of 𝕩
+// 'integer ↑ any' -> array - the first 𝕨 major cells of 𝕩, or the last -𝕨 when negative, padded with fills past the end of 𝕩
+// 'list ↑ any'    -> array - each leading axis of 𝕩 taken by the matching integer in 𝕨
+static fern_Box fern_UPWARDS_ARROW_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    return affixes(x, false);
+  case fern_Evokation_dyad:
+    return take_drop(x, w, false);
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_UPWARDS_ARROW_fn = { .type = fern_FunctionType_c, .c = fern_UPWARDS_ARROW_evokation0 };
+fern_Box fern_UPWARDS_ARROW(void) {
+  return fern_pack_function(&fern_UPWARDS_ARROW_fn);
+}
+
+// ↓ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'array ↓'       -> list  - the suffixes of 𝕩
+// 'integer ↓ any' -> array - 𝕩 without its first 𝕨 major cells, or its last -𝕨 when negative
+// 'list ↓ any'    -> array - each leading axis of 𝕩 dropped by the matching integer in 𝕨
+static fern_Box fern_DOWNWARDS_ARROW_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    return affixes(x, true);
+  case fern_Evokation_dyad:
+    return take_drop(x, w, true);
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_DOWNWARDS_ARROW_fn = { .type = fern_FunctionType_c, .c = fern_DOWNWARDS_ARROW_evokation0 };
+fern_Box fern_DOWNWARDS_ARROW(void) {
+  return fern_pack_function(&fern_DOWNWARDS_ARROW_fn);
+}
+// ↕ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'natural ↕' -> 1d array - make an array of natural numbers from 0 to 𝕩
+static fern_Box fern_UP_DOWN_ARROW_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    {
+      uint32_t shape = fern_force_natural(x);
+
+      union fern_Data data;
+      uint32_t * nums = fern_init_data(&data, fern_Format_natural_32_bit, shape);
+
+      for(uint32_t i = 0; i < shape; i++) {
+        nums[i] = i;
+      }
+
+      return fern_mk_array2(1, &shape, &data, fern_DIGIT_ZERO());
+    }
+  case fern_Evokation_dyad:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_UP_DOWN_ARROW_fn = { .type = fern_FunctionType_c, .c = fern_UP_DOWN_ARROW_evokation0 };
+fern_Box fern_UP_DOWN_ARROW(void) {
+  return fern_pack_function(&fern_UP_DOWN_ARROW_fn);
+}
+
+// « ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 𝕩 with k new major cells pushed in at the end («) or the front (»), keeping the shape of 𝕩. the kept cells of 𝕩 are one
+// block move, the new cells are 𝕨 or a run of fills when there is no 𝕨
+static fern_Box shift_cells(fern_Box x, fern_Box w, bool monad, bool before) {
+  if(!fern_is_array(x) || fern_array_rank(fern_read_array(fern_unpack_array(x))) == 0) {
+    fern_fatal_error(before ? "«: 𝕩 must have rank at least 1" : "»: 𝕩 must have rank at least 1");
+  }
+  fern_Array xa = fern_unpack_array(x);
+  fern_ArrayReader xar = fern_read_array(xa);
+  uint32_t rank = fern_array_rank(xar);
+  uint32_t n = fern_array_axis_length(xar, 0);
+  uint32_t size = fern_array_num_cells(xar);
+  uint32_t stride = n ? size / n : 0;
+  fern_Box fill = fern_array_fill(xar);
+
+  // the kernels move ranges of the data of both arguments, so cells read as the fill are written out first
+  union fern_Data x_full;
+  if(!fern_array_complete(xar)) {
+    fern_internal_expand_fill(xar, &x_full);
+  }
+  fern_DataReader x_cells = fern_array_complete(xar) ? xar.cells : fern_read_data(&x_full);
+
+  // the new cells, k of them
+  uint32_t k = 1;
+  union fern_Data atom;
+  fern_Data new_data = &atom;
+  bool new_owned = true;
+  if(monad) {
+    *(fern_Box *)fern_init_data(&atom, fern_Format_box, 1) = fill;
+  } else {
+    const char * error = before ? "«: 𝕨 must match the cells of 𝕩" : "»: 𝕨 must match the cells of 𝕩";
+    if(fern_is_array(w)) {
+      fern_ArrayReader war = fern_read_array(fern_unpack_array(w));
+      uint32_t w_rank = fern_array_rank(war);
+      fern_assert_fatal_error(w_rank == rank || w_rank + 1 == rank, error);
+      uint32_t lead = rank - w_rank;
+      for(uint32_t i = 1; i < rank; i++) {
+        fern_assert_fatal_error(fern_array_axis_length(war, i - lead) == fern_array_axis_length(xar, i), error);
+      }
+      k = lead ? 1 : fern_array_axis_length(war, 0);
+      if(fern_array_complete(war)) {
+        new_data = &fern_unpack_array(w)->cells;
+        new_owned = false;
+      } else {
+        fern_internal_expand_fill(war, &atom);
+      }
+    } else {
+      fern_assert_fatal_error(rank == 1, error);
+      *(fern_Box *)fern_init_data(&atom, fern_Format_box, 1) = w;
+    }
+  }
+  fern_DataReader new_cells = fern_read_data(new_data);
+
+  fern_Format format = fern_internal_unify_format(x_cells.format, fern_internal_cell_format(new_cells));
+  union fern_Data data;
+  void * dst = fern_init_data(&data, format, size);
+
+  // kept cells of 𝕩 and where they go, then where the new cells go and which of them are kept
+  uint32_t kept = k < n ? n - k : 0;
+  uint32_t added = n - kept;
+  uint32_t x_from = before ? k : 0;
+  uint32_t x_to = before ? 0 : added;
+  uint32_t new_from = before ? k - added : 0;
+  uint32_t new_to = before ? kept : 0;
+  fern_internal_convert_range(dst, format, x_to * stride, x_cells, x_from * stride, kept * stride);
+  if(monad) {
+    fern_internal_fill_cells(dst, format, new_to * stride, added * stride, fill);
+  } else {
+    fern_internal_convert_range(dst, format, new_to * stride, new_cells, new_from * stride, added * stride);
+  }
+  if(!fern_array_complete(xar)) {
+    fern_free_data(&x_full);
+  }
+  if(new_owned) {
+    fern_free_data(&atom);
+  }
+
+  fern_Box result = fern_mk_array(&xa->shape, &data, fill);
+  fern_free_data(&data);
+  return result;
+}
+
+// 'array «'       -> array - the major cells of 𝕩 moved one place towards the front, with a cell of fills at the end
+// 'any « array'   -> array - 𝕩 ∾ 𝕨 without its first ≠𝕨 major cells, a 𝕨 of lower rank is one major cell
+static fern_Box fern_LEFT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    return shift_cells(x, w, true, true);
+  case fern_Evokation_dyad:
+    return shift_cells(x, w, false, true);
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_LEFT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK_fn = { .type = fern_FunctionType_c, .c = fern_LEFT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK_evokation0 };
+fern_Box fern_LEFT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK(void) {
+  return fern_pack_function(&fern_LEFT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK_fn);
+}
+
+// » ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'array »'       -> array - the major cells of 𝕩 moved one place towards the end, with a cell of fills at the front
+// 'any » array'   -> array - the first ≠𝕩 major cells of 𝕨 ∾ 𝕩, a 𝕨 of lower rank is one major cell
+static fern_Box fern_RIGHT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    return shift_cells(x, w, true, false);
+  case fern_Evokation_dyad:
+    return shift_cells(x, w, false, false);
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_RIGHT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK_fn = { .type = fern_FunctionType_c, .c = fern_RIGHT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK_evokation0 };
+fern_Box fern_RIGHT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK(void) {
+  return fern_pack_function(&fern_RIGHT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK_fn);
+}
+// ⌽ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 𝕨 as a rotation of an axis of length n, in [0, n)
+static uint32_t rotate_amount(fern_Box w, uint32_t n) {
+  fern_assert_fatal_error(fern_is_number(w) && round(w.number) == w.number, "⌽: 𝕨 must consist of integers");
+  if(n == 0) {
+    return 0;
+  }
+  int64_t amount = (int64_t)fmod(w.number, n);
+  return amount < 0 ? amount + n : amount;
+}
+
+// 'array ⌽'         -> array - the major cells of 𝕩 in reverse order
+// 'integer ⌽ array' -> array - the major cells of 𝕩 rotated left by 𝕨
+// 'list ⌽ array'    -> array - each leading axis of 𝕩 rotated by the matching integer in 𝕨
+static fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STILE_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    {
+      if(!fern_is_array(x) || fern_array_rank(fern_read_array(fern_unpack_array(x))) == 0) {
+        fern_fatal_error("⌽: Argument cannot be a unit");
+      }
+      fern_Array xa = fern_unpack_array(x);
+      fern_ArrayReader xar = fern_read_array(xa);
+
+      // the kernels move blocks of the data of 𝕩, so cells read as the fill are written out first
+      uint32_t n = fern_array_axis_length(xar, 0);
+      union fern_Data full;
+      if(!fern_array_complete(xar)) {
+        fern_internal_expand_fill(xar, &full);
+      }
+      union fern_Data data;
+      fern_internal_reverse(fern_array_complete(xar) ? xar.cells : fern_read_data(&full), n ? fern_array_num_cells(xar) / n : 0, &data);
+      if(!fern_array_complete(xar)) {
+        fern_free_data(&full);
+      }
+      return fern_mk_array(&xa->shape, &data, fern_array_fill(xar));
+    }
+  case fern_Evokation_dyad:
+    {
+      if(!fern_is_array(x) || fern_array_rank(fern_read_array(fern_unpack_array(x))) == 0) {
+        fern_fatal_error("⌽: 𝕩 must have rank at least 1");
+      }
+      fern_Array xa = fern_unpack_array(x);
+      fern_ArrayReader xar = fern_read_array(xa);
+      uint32_t rank = fern_array_rank(xar);
+
+      uint32_t num_amounts = 1;
+      fern_ArrayReader war = fern_is_array(w) ? fern_read_array(fern_unpack_array(w)) : xar;
+      if(fern_is_array(w)) {
+        fern_assert_fatal_error(fern_array_rank(war) <= 1, "⌽: 𝕨 must have rank at most 1");
+        num_amounts = fern_array_num_cells(war);
+      }
+      fern_assert_fatal_error(num_amounts <= rank, "⌽: Length of 𝕨 must be at most rank of 𝕩");
+
+      // each rotated axis is one pass of block moves, the data ping-pongs between the result and a scratch copy
+      union fern_Data data;
+      if(fern_array_complete(xar)) {
+        fern_clone_data(&data, &xa->cells);
+      } else {
+        fern_internal_expand_fill(xar, &data);
+      }
+      uint32_t size = fern_array_num_cells(xar);
+      uint32_t outer = 1;
+      uint32_t inner = size;
+      for(uint32_t k = 0; k < num_amounts; k++) {
+        uint32_t n = fern_array_axis_length(xar, k);
+        inner = n ? inner / n : 0;
+        uint32_t amount = rotate_amount(fern_is_array(w) ? fern_array_get_cell(war, k) : w, n);
+        if(amount != 0) {
+          union fern_Data rotated;
+          void * dst = fern_init_data(&rotated, fern_read_data(&data).format, size);
+          fern_internal_rotate(fern_read_data(&data), outer, n, inner, amount, dst);
+          fern_free_data(&data);
+          data = rotated;
+        }
+        outer *= n;
+      }
+
+      return fern_mk_array(&xa->shape, &data, fern_array_fill(xar));
+    }
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STILE_fn = { .type = fern_FunctionType_c, .c = fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STILE_evokation0 };
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STILE(void) {
+  return fern_pack_function(&fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STILE_fn);
+}
+
+// ⍉ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'array ⍉'         -> array - the first axis of 𝕩 moved to the end
+// 'natural ⍉ array' -> array - 𝕨 ⍉ with a list of one axis
+// 'list ⍉ array'    -> array - axis k of 𝕩 moved to axis k⊑𝕨 of the result, axes sent to the same place take their diagonal.
+//                               the axes of 𝕩 after ≠𝕨 take the result axes not in 𝕨, in order
+static fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_BACKSLASH_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  if(evokation == fern_Evokation_write_to_backend || evokation == fern_Evokation_inverse) {
+    fern_fatal_error("not implemented");
+  }
+  if(!fern_is_array(x)) {
+    if(evokation == fern_Evokation_monad) {
+      return x;
+    }
+    fern_fatal_error("⍉: 𝕩 must be an array");
+  }
+
+  fern_Array xa = fern_unpack_array(x);
+  fern_ArrayReader xar = fern_read_array(xa);
+  uint32_t rank = fern_array_rank(xar);
+  if(evokation == fern_Evokation_monad && rank <= 1) {
+    return x;
+  }
+
+  // axis of the result each axis of 𝕩 goes to
+  uint32_t * axes = malloc(sizeof(uint32_t) * (rank ? rank : 1) * 5);
+  uint32_t * x_strides = axes + rank;
+  uint32_t * shape = x_strides + rank;
+  uint32_t * strides = shape + rank;
+  uint32_t * named = strides + rank;
+  uint32_t result_rank = rank;
+
+  if(evokation == fern_Evokation_monad) {
+    axes[0] = rank - 1;
+    for(uint32_t k = 1; k < rank; k++) {
+      axes[k] = k - 1;
+    }
+  } else {
+    fern_ArrayReader war = fern_is_array(w) ? fern_read_array(fern_unpack_array(w)) : xar;
+    uint32_t num_axes = fern_is_array(w) ? fern_array_num_cells(war) : 1;
+    fern_assert_fatal_error(!fern_is_array(w) || fern_array_rank(war) <= 1, "⍉: 𝕨 must have rank at most 1");
+    fern_assert_fatal_error(num_axes <= rank, "⍉: Length of 𝕨 must be at most rank of 𝕩");
+    // each axis named twice in 𝕨 takes one away from the rank of the result
+    memset(named, 0, sizeof(uint32_t) * rank);
+    for(uint32_t k = 0; k < num_axes; k++) {
+      int64_t axis = fern_is_array(w) ? fern_array_get_natural(war, k) : fern_force_natural(w);
+      fern_assert_fatal_error(axis >= 0 && axis < rank, "⍉: Axis in 𝕨 too large");
+      axes[k] = axis;
+      result_rank -= named[axis];
+      named[axis] = 1;
+    }
+    for(uint32_t k = 0; k < num_axes; k++) {
+      fern_assert_fatal_error(axes[k] < result_rank, "⍉: Axes in 𝕨 must not skip a result axis");
+    }
+    uint32_t next = 0;
+    for(uint32_t k = num_axes; k < rank; k++) {
+      while(named[next]) {
+        next++;
+      }
+      axes[k] = next++;
+    }
+  }
+
+  uint32_t stride = 1;
+  for(uint32_t k = rank; k-- > 0;) {
+    x_strides[k] = stride;
+    stride *= fern_array_axis_length(xar, k);
+  }
+
+  // merged axes run along the diagonal: the shortest length and the sum of the strides
+  for(uint32_t j = 0; j < result_rank; j++) {
+    shape[j] = UINT32_MAX;
+    strides[j] = 0;
+  }
+  for(uint32_t k = 0; k < rank; k++) {
+    uint32_t length = fern_array_axis_length(xar, k);
+    shape[axes[k]] = length < shape[axes[k]] ? length : shape[axes[k]];
+    strides[axes[k]] += x_strides[k];
+  }
+  for(uint32_t j = 0; j < result_rank; j++) {
+    fern_assert_fatal_error(shape[j] != UINT32_MAX, "⍉: Axes in 𝕨 must not skip a result axis");
+  }
+
+  // the strides index the data of 𝕩, so cells read as the fill are written out first
+  union fern_Data full;
+  if(!fern_array_complete(xar)) {
+    fern_internal_expand_fill(xar, &full);
+  }
+  union fern_Data data;
+  fern_internal_permute(fern_array_complete(xar) ? xar.cells : fern_read_data(&full), result_rank, shape, strides, &data);
+  if(!fern_array_complete(xar)) {
+    fern_free_data(&full);
+  }
+  union fern_Data shape_data;
+  fern_init_shape(&shape_data, result_rank, shape);
+  free(axes);
+
+  fern_Box result = fern_mk_array(&shape_data, &data, fern_array_fill(xar));
+  fern_free_data(&shape_data);
+  return result;
+}
+static struct fern_Function fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_BACKSLASH_fn = { .type = fern_FunctionType_c, .c = fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_BACKSLASH_evokation0 };
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_BACKSLASH(void) {
+  return fern_pack_function(&fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_BACKSLASH_fn);
+}
+
+// / ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'list /'          -> list of natural numbers - each index of 𝕩 repeated 𝕩 times, the set positions of a boolean 𝕩
+// 'list / array'    -> array                   - each major cell of 𝕩 repeated by the matching natural in 𝕨
+// 'natural / array' -> array                   - each major cell of 𝕩 repeated 𝕨 times
+static fern_Box fern_SOLIDUS_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    {
+      if(!fern_is_array(x) || fern_array_rank(fern_read_array(fern_unpack_array(x))) != 1) {
+        fern_fatal_error("/: Argument must be a list");
+      }
+      fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+      union fern_Data full;
+      if(!fern_array_complete(xar)) {
+        fern_internal_expand_fill(xar, &full);
+      }
+      union fern_Data data;
+      fern_internal_indices(fern_array_complete(xar) ? xar.cells : fern_read_data(&full), &data);
+      if(!fern_array_complete(xar)) {
+        fern_free_data(&full);
+      }
+      return fern_mk_array3(&data, fern_DIGIT_ZERO());
+    }
+  case fern_Evokation_dyad:
+    {
+      if(!fern_is_array(x) || fern_array_rank(fern_read_array(fern_unpack_array(x))) == 0) {
+        fern_fatal_error("/: 𝕩 must have rank at least 1");
+      }
+      fern_Array xa = fern_unpack_array(x);
+      fern_ArrayReader xar = fern_read_array(xa);
+
+      uint32_t rank = fern_array_rank(xar);
+      uint32_t n = fern_array_axis_length(xar, 0);
+      uint32_t stride = n ? fern_array_num_cells(xar) / n : 0;
+
+      union fern_Data repeat;
+      if(fern_is_array(w)) {
+        fern_ArrayReader war = fern_read_array(fern_unpack_array(w));
+        if(fern_array_rank(war) != 1 || fern_array_num_cells(war) != n) {
+          fern_fatal_error("/: Length of 𝕨 must equal length of 𝕩");
+        }
+        if(fern_array_complete(war)) {
+          fern_clone_data(&repeat, &fern_unpack_array(w)->cells);
+        } else {
+          fern_internal_expand_fill(war, &repeat);
+        }
+      } else {
+        int64_t k = fern_force_natural(w);
+        fern_assert_fatal_error(k >= 0, "/: 𝕨 must consist of natural numbers");
+        uint32_t * counts = fern_init_data(&repeat, fern_Format_natural_32_bit, n);
+        for(uint32_t i = 0; i < n; i++) {
+          counts[i] = k;
+        }
+      }
+
+      // the kernels index the data of 𝕩, so cells read as the fill are written out first
+      union fern_Data full;
+      if(!fern_array_complete(xar)) {
+        fern_internal_expand_fill(xar, &full);
+      }
+      union fern_Data cells;
+      uint32_t length = fern_internal_replicate(fern_read_data(&repeat), fern_array_complete(xar) ? xar.cells : fern_read_data(&full), stride, &cells);
+      fern_free_data(&repeat);
+      if(!fern_array_complete(xar)) {
+        fern_free_data(&full);
+      }
+
+      uint32_t * shape = malloc(sizeof(uint32_t) * rank);
+      shape[0] = length;
+      for(uint32_t i = 1; i < rank; i++) {
+        shape[i] = fern_array_axis_length(xar, i);
+      }
+      union fern_Data shape_data;
+      fern_init_shape(&shape_data, rank, shape);
+      free(shape);
+
+      fern_Box result = fern_mk_array(&shape_data, &cells, fern_array_fill(xar));
+      fern_free_data(&shape_data);
+      return result;
+    }
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_SOLIDUS_fn = { .type = fern_FunctionType_c, .c = fern_SOLIDUS_evokation0 };
+fern_Box fern_SOLIDUS(void) {
+  return fern_pack_function(&fern_SOLIDUS_fn);
+}
+
+// ⍋ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'array ⍋' -> 1d array of natural numbers - the stable permutation that sorts the major cells of 𝕩 ascending
+static fern_Box grade_major_cells(fern_Box x, bool down) {
+  if(!fern_is_array(x) || fern_array_rank(fern_read_array(fern_unpack_array(x))) == 0) {
+    fern_fatal_error(down ? "⍒: Argument cannot have rank 0" : "⍋: Argument cannot have rank 0");
+  }
+
+  fern_Array xa = fern_unpack_array(x);
+  fern_ArrayReader xar = fern_read_array(xa);
+
+  uint32_t n = fern_array_axis_length(xar, 0);
+
+  union fern_Data data;
+  fern_internal_grade_major(xar, down, &data);
+
+  return fern_mk_array2(1, &n, &data, fern_DIGIT_ZERO());
+}
+static fern_Box fern_APL_FUNCTIONAL_SYMBOL_DELTA_STILE_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    return grade_major_cells(x, false);
+  case fern_Evokation_dyad:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_APL_FUNCTIONAL_SYMBOL_DELTA_STILE_fn = { .type = fern_FunctionType_c, .c = fern_APL_FUNCTIONAL_SYMBOL_DELTA_STILE_evokation0 };
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_DELTA_STILE(void) {
+  return fern_pack_function(&fern_APL_FUNCTIONAL_SYMBOL_DELTA_STILE_fn);
+}
+
+// ⍒ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'array ⍒' -> 1d array of natural numbers - the stable permutation that sorts the major cells of 𝕩 descending
+static fern_Box fern_APL_FUNCTIONAL_SYMBOL_DEL_STILE_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    return grade_major_cells(x, true);
+  case fern_Evokation_dyad:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_APL_FUNCTIONAL_SYMBOL_DEL_STILE_fn = { .type = fern_FunctionType_c, .c = fern_APL_FUNCTIONAL_SYMBOL_DEL_STILE_evokation0 };
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_DEL_STILE(void) {
+  return fern_pack_function(&fern_APL_FUNCTIONAL_SYMBOL_DEL_STILE_fn);
+}
+
+// ⊏ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'array ⊏'           -> array - the first major cell of 𝕩
+// 'integer ⊏ array'   -> array - the major cell of 𝕩 at index 𝕨, negative indices count from the end
+// 'integers ⊏ array'  -> array - the major cells of 𝕩 at each index in 𝕨, with shape 𝕨 ∾ 1↓≢𝕩
+static fern_Box fern_SQUARE_IMAGE_OF_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    return CALL_2(fern_SQUARE_IMAGE_OF(), x, fern_DIGIT_ZERO());
+  case fern_Evokation_dyad:
+    {
+      if(!fern_is_array(x) || fern_array_rank(fern_read_array(fern_unpack_array(x))) == 0) {
+        fern_fatal_error("⊏: 𝕩 must have rank at least 1");
+      }
+      fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+      uint32_t x_rank = fern_array_rank(xar);
+      uint32_t n = fern_array_axis_length(xar, 0);
+      uint32_t stride = n ? fern_array_num_cells(xar) / n : 0;
+
+      // an atom index selects a single major cell, the result has rank 0 in place of the index
+      fern_ArrayReader war = fern_is_array(w) ? fern_read_array(fern_unpack_array(w)) : xar;
+      uint32_t w_rank = fern_is_array(w) ? fern_array_rank(war) : 0;
+
+      // the gather indexes the data of both arguments, so cells read as the fill are written out first
+      bool x_full = fern_array_complete(xar);
+      bool w_full = !fern_is_array(w) || fern_array_complete(war);
+      union fern_Data x_cells;
+      union fern_Data w_cells;
+      if(!x_full) {
+        fern_internal_expand_fill(xar, &x_cells);
+      }
+      if(!w_full) {
+        fern_internal_expand_fill(war, &w_cells);
+      }
+      fern_DataReader indices = !fern_is_array(w) ? (fern_DataReader) { .format = fern_Format_box, .size = 1, .box = &w }
+        : w_full ? war.cells
+        : fern_read_data(&w_cells);
+
+      union fern_Data data;
+      fern_internal_select(indices, x_full ? xar.cells : fern_read_data(&x_cells), n, stride, &data);
+      if(!x_full) {
+        fern_free_data(&x_cells);
+      }
+      if(!w_full) {
+        fern_free_data(&w_cells);
+      }
+
+      uint32_t * shape = malloc(sizeof(uint32_t) * (w_rank + x_rank));
+      for(uint32_t i = 0; i < w_rank; i++) {
+        shape[i] = fern_array_axis_length(war, i);
+      }
+      for(uint32_t i = 1; i < x_rank; i++) {
+        shape[w_rank + i - 1] = fern_array_axis_length(xar, i);
+      }
+      union fern_Data shape_data;
+      fern_init_shape(&shape_data, w_rank + x_rank - 1, shape);
+      free(shape);
+
+      fern_Box result = fern_mk_array(&shape_data, &data, fern_array_fill(xar));
+      fern_free_data(&shape_data);
+      return result;
+    }
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_SQUARE_IMAGE_OF_fn = { .type = fern_FunctionType_c, .c = fern_SQUARE_IMAGE_OF_evokation0 };
+fern_Box fern_SQUARE_IMAGE_OF(void) {
+  return fern_pack_function(&fern_SQUARE_IMAGE_OF_fn);
+}
+
+// ⊑ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// the cell of the list 𝕩 that a number 𝕨 picks, a negative 𝕨 counting from the end
+static uint32_t pick_index(fern_ArrayReader xar, fern_Box w) {
+  fern_assert_fatal_error(fern_array_rank(xar) == 1, "⊑: 𝕩 must be a list when 𝕨 is a number");
+  fern_assert_fatal_error(fern_is_number(w) && w.number == floor(w.number), "⊑: Indices in 𝕨 must be integers");
+  double n = fern_array_num_cells(xar);
+  fern_assert_fatal_error(w.number >= -n && w.number < n, "⊑: Indexing out-of-bounds");
+  return w.number < 0 ? w.number + n : w.number;
+}
+
+// 'list ⊑ integer' -> any - the cell of 𝕩 at index 𝕨, from the end when 𝕨 is negative
+static fern_Box fern_SQUARE_IMAGE_OF_OR_EQUAL_TO_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_dyad:
+    {
+      fern_Array xa = fern_unpack_array(x);
+      fern_ArrayReader xar = fern_read_array(xa);
+      return fern_array_get_cell(xar, pick_index(xar, w));
     }
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
@@ -731,10 +1819,269 @@ fern_Box fern_SQUARE_IMAGE_OF_OR_EQUAL_TO(void) {
 }
 
 // ⊐ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'array ⊐ any' -> array of natural numbers - for each cell of 𝕩 the index of its first occurrence among the major cells of 𝕨, or
+// ≠𝕨 if missing. the cells of 𝕩 searched for have the rank of the major cells of 𝕨
+static void boxed_cells(fern_Box x, uint32_t k, fern_Data result);
+static fern_Box search_cells(fern_Search search, fern_Box list, fern_Box cells, bool member, const char * error, const char * rank_error) {
+  if(!fern_is_array(list) || fern_array_rank(fern_read_array(fern_unpack_array(list))) == 0) {
+    fern_fatal_error(error);
+  }
+  fern_ArrayReader lar = fern_read_array(fern_unpack_array(list));
+  uint32_t k = fern_array_rank(lar) - 1;
+  uint32_t rank = fern_is_array(cells) ? fern_array_rank(fern_read_array(fern_unpack_array(cells))) : 0;
+  fern_assert_fatal_error(rank >= k, rank_error);
+
+  // an atom is searched for as a single cell, giving a rank 0 result
+  union fern_Data shape;
+  if(fern_is_array(cells)) {
+    fern_ArrayReader car = fern_read_array(fern_unpack_array(cells));
+    uint32_t * axes = malloc(sizeof(uint32_t) * (rank - k ? rank - k : 1));
+    for(uint32_t i = 0; i < rank - k; i++) {
+      axes[i] = fern_array_axis_length(car, i);
+    }
+    fern_init_shape(&shape, rank - k, axes);
+    free(axes);
+  } else {
+    fern_init_shape(&shape, 0, NULL);
+  }
+
+  // lists stored in full are searched as their data. higher rank cells, and cells read as the fill, are searched as boxes
+  union fern_Data list_boxes;
+  union fern_Data cells_boxes;
+  bool boxed = k != 0 || !fern_array_complete(lar) || (fern_is_array(cells) && !fern_array_complete(fern_read_array(fern_unpack_array(cells))));
+  if(boxed) {
+    boxed_cells(list, k, &list_boxes);
+    boxed_cells(cells, k, &cells_boxes);
+  }
+  fern_DataReader list_reader = boxed ? fern_read_data(&list_boxes) : lar.cells;
+  fern_DataReader cells_reader = boxed ? fern_read_data(&cells_boxes)
+    : fern_is_array(cells) ? fern_read_array(fern_unpack_array(cells)).cells
+    : (fern_DataReader) { .format = fern_Format_box, .size = 1, .box = &cells };
+
+  uint32_t n = list_reader.size;
+  uint32_t m = cells_reader.size;
+  union fern_Data data;
+  if(member) {
+    uint32_t * found = malloc(sizeof(uint32_t) * (m ? m : 1));
+    fern_internal_search(search, list_reader, cells_reader, found);
+    uint8_t * bits = fern_init_data(&data, fern_Format_natural_1_bit, m);
+    memset(bits, 0, (m + 7) >> 3);
+    for(uint32_t i = 0; i < m; i++) {
+      bits[i >> 3] |= (found[i] < n) << (i & 7);
+    }
+    free(found);
+  } else {
+    fern_internal_search(search, list_reader, cells_reader, fern_init_data(&data, fern_Format_natural_32_bit, m));
+  }
+  if(boxed) {
+    fern_free_data(&list_boxes);
+    fern_free_data(&cells_boxes);
+  }
+
+  fern_Box result = fern_mk_array(&shape, &data, fern_DIGIT_ZERO());
+  fern_free_data(&shape);
+  return result;
+}
+static fern_Box fern_SQUARE_ORIGINAL_OF_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_dyad:
+    return search_cells(fern_Search_index_of, w, x, false, "⊐: 𝕨 must have rank at least 1", "⊐: Rank of 𝕩 must be at least the cell rank of 𝕨");
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_SQUARE_ORIGINAL_OF_fn = { .type = fern_FunctionType_c, .c = fern_SQUARE_ORIGINAL_OF_evokation0 };
+fern_Box fern_SQUARE_ORIGINAL_OF(void) {
+  return fern_pack_function(&fern_SQUARE_ORIGINAL_OF_fn);
+}
+
 // ⊒ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'array ⊒ any' -> array of natural numbers - like ⊐, but each index of 𝕨 is only used once, later equal cells get later indices
+static fern_Box fern_SQUARE_ORIGINAL_OF_OR_EQUAL_TO_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_dyad:
+    return search_cells(fern_Search_progressive_index_of, w, x, false, "⊒: 𝕨 must have rank at least 1", "⊒: Rank of 𝕩 must be at least the cell rank of 𝕨");
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_SQUARE_ORIGINAL_OF_OR_EQUAL_TO_fn = { .type = fern_FunctionType_c, .c = fern_SQUARE_ORIGINAL_OF_OR_EQUAL_TO_evokation0 };
+fern_Box fern_SQUARE_ORIGINAL_OF_OR_EQUAL_TO(void) {
+  return fern_pack_function(&fern_SQUARE_ORIGINAL_OF_OR_EQUAL_TO_fn);
+}
+
 // ∊ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'any ∊ array' -> array of booleans - for each cell of 𝕨, 1 if it is a major cell of 𝕩
+static fern_Box fern_SMALL_ELEMENT_OF_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_dyad:
+    return search_cells(fern_Search_index_of, x, w, true, "∊: 𝕩 must have rank at least 1", "∊: Rank of 𝕨 must be at least the cell rank of 𝕩");
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_SMALL_ELEMENT_OF_fn = { .type = fern_FunctionType_c, .c = fern_SMALL_ELEMENT_OF_evokation0 };
+fern_Box fern_SMALL_ELEMENT_OF(void) {
+  return fern_pack_function(&fern_SMALL_ELEMENT_OF_fn);
+}
+
 // ⍷ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'any ⍷ any' -> array of booleans - 1 where the window of 𝕩 starting at that position matches 𝕨, with shape 1+(≢𝕩)-≢𝕨 and
+//                                    𝕨 taking leading axes of length 1 up to the rank of 𝕩
+static fern_Box fern_APL_FUNCTIONAL_SYMBOL_EPSILON_UNDERBAR_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_dyad:
+    {
+      fern_ArrayReader xar = fern_read_array(fern_is_array(x) ? fern_unpack_array(x) : NULL);
+      fern_ArrayReader war = fern_read_array(fern_is_array(w) ? fern_unpack_array(w) : NULL);
+      uint32_t x_rank = fern_is_array(x) ? fern_array_rank(xar) : 0;
+      uint32_t w_rank = fern_is_array(w) ? fern_array_rank(war) : 0;
+      fern_assert_fatal_error(w_rank <= x_rank, "⍷: Rank of 𝕨 must be at most rank of 𝕩");
+
+      // an atom is a single cell, searched for as a list of one
+      uint32_t rank = x_rank ? x_rank : 1;
+      uint32_t * shape = malloc(sizeof(uint32_t) * rank * 3);
+      uint32_t * x_shape = shape + rank;
+      uint32_t * w_shape = x_shape + rank;
+      for(uint32_t k = 0; k < rank; k++) {
+        x_shape[k] = x_rank ? fern_array_axis_length(xar, k) : 1;
+        w_shape[k] = k + w_rank >= rank && w_rank ? fern_array_axis_length(war, k + w_rank - rank) : 1;
+        shape[k] = x_shape[k] >= w_shape[k] ? x_shape[k] - w_shape[k] + 1 : 0;
+      }
+
+      // the windows index the data of both arguments, so cells read as the fill are written out first
+      union fern_Data x_full;
+      union fern_Data w_full;
+      if(!fern_array_complete(xar)) {
+        fern_internal_expand_fill(xar, &x_full);
+      }
+      if(!fern_array_complete(war)) {
+        fern_internal_expand_fill(war, &w_full);
+      }
+
+      union fern_Data data;
+      fern_internal_find(
+          !fern_is_array(w) ? (fern_DataReader) { .format = fern_Format_box, .size = 1, .box = &w } : fern_array_complete(war) ? war.cells : fern_read_data(&w_full), w_shape
+        , !fern_is_array(x) ? (fern_DataReader) { .format = fern_Format_box, .size = 1, .box = &x } : fern_array_complete(xar) ? xar.cells : fern_read_data(&x_full), x_shape
+        , rank
+        , &data
+        );
+      if(!fern_array_complete(xar)) {
+        fern_free_data(&x_full);
+      }
+      if(!fern_array_complete(war)) {
+        fern_free_data(&w_full);
+      }
+
+      fern_Box result = fern_mk_array2(x_rank, shape, &data, fern_DIGIT_ZERO());
+      fern_free_data(&data);
+      free(shape);
+      return result;
+    }
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_APL_FUNCTIONAL_SYMBOL_EPSILON_UNDERBAR_fn = { .type = fern_FunctionType_c, .c = fern_APL_FUNCTIONAL_SYMBOL_EPSILON_UNDERBAR_evokation0 };
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_EPSILON_UNDERBAR(void) {
+  return fern_pack_function(&fern_APL_FUNCTIONAL_SYMBOL_EPSILON_UNDERBAR_fn);
+}
+
 // ⊔ ----------------------------------------------------------------------------------------------------------------------------------------------------------
+// 'list ⊔'      -> list of lists - indices of 𝕩 grouped by the group index in each cell of 𝕩
+// 'list ⊔ list' -> list of lists - cells of 𝕩 grouped by the group index in the matching cell of 𝕨
+//
+// GroupLen and GroupOrd fused, the lengths from the histogram pass are the offsets for the ordering pass without building an array
+static fern_Box fern_SQUARE_CUP_evokation0(fern_Evokation evokation, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    w = x;
+  case fern_Evokation_dyad:
+    {
+      if(!fern_is_array(w) || !fern_is_array(x)) {
+        fern_fatal_error("⊔: Arguments must be lists");
+      }
+      fern_ArrayReader war = fern_read_array(fern_unpack_array(w));
+      fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+      if(fern_array_rank(war) != 1 || fern_array_rank(xar) != 1 || fern_array_num_cells(war) != fern_array_num_cells(xar)) {
+        fern_fatal_error("not implemented");
+      }
+
+      uint32_t num_groups;
+      uint32_t * lengths = fern_internal_group_lengths(war, 0, &num_groups);
+      uint32_t * offsets = malloc(sizeof(uint32_t) * (num_groups ? num_groups : 1));
+      memcpy(offsets, lengths, sizeof(uint32_t) * num_groups);
+
+      uint32_t total = 0;
+      for(uint32_t k = 0; k < num_groups; k++) {
+        total += lengths[k];
+      }
+      uint32_t * order = malloc(sizeof(uint32_t) * (total ? total : 1));
+      fern_internal_group_order(war, offsets, num_groups, order);
+      free(offsets);
+
+      union fern_Data groups;
+      fern_Box * group = fern_init_data(&groups, fern_Format_box, num_groups);
+      uint32_t start = 0;
+      for(uint32_t k = 0; k < num_groups; k++) {
+        union fern_Data cells;
+        if(evokation == fern_Evokation_monad) {
+          uint32_t * indices = fern_init_data(&cells, fern_Format_natural_32_bit, lengths[k]);
+          memcpy(indices, order + start, sizeof(uint32_t) * lengths[k]);
+          group[k] = fern_mk_array3(&cells, fern_DIGIT_ZERO());
+        } else {
+          if(fern_array_complete(xar)) {
+            void * dst = fern_init_data(&cells, xar.cells.format, lengths[k]);
+            for(uint32_t i = 0; i < lengths[k]; i++) {
+              fern_internal_copy_cells(dst, i, xar.cells, order[start + i], 1);
+            }
+          } else {
+            fern_Box * dst = fern_init_data(&cells, fern_Format_box, lengths[k]);
+            for(uint32_t i = 0; i < lengths[k]; i++) {
+              dst[i] = fern_array_get_cell(xar, order[start + i]);
+            }
+          }
+          group[k] = fern_mk_array3(&cells, fern_array_fill(xar));
+        }
+        start += lengths[k];
+      }
+      free(order);
+      free(lengths);
+
+      return fern_mk_array2(1, &num_groups, &groups, fern_EMPTY_ARRAY());
+    }
+  case fern_Evokation_write_to_backend:
+    fern_fatal_error("not implemented");
+  case fern_Evokation_inverse:
+    fern_fatal_error("not implemented");
+  }
+  return fern_DIGIT_ZERO();
+}
+static struct fern_Function fern_SQUARE_CUP_fn = { .type = fern_FunctionType_c, .c = fern_SQUARE_CUP_evokation0 };
+fern_Box fern_SQUARE_CUP(void) {
+  return fern_pack_function(&fern_SQUARE_CUP_fn);
+}
+
 // ! ----------------------------------------------------------------------------------------------------------------------------------------------------------
 // '𝕩 !'   -> nothing - panic! if 𝕩 != 1 printing 𝕩
 // '𝕩 ! 𝕨' -> nothing - panic! if 𝕩 != 1 printing 𝕨
@@ -759,14 +2106,125 @@ fern_Box fern_EXCLAMATION_MARK(void) {
   return fern_pack_function(&fern_EXCLAMATION_MARK_fn);
 }
 
+// ============================================================================================================================================================
+// scalar primitives are recognized by their evokation, so modifiers can run native kernels instead of evoking 𝔽 per cell
+fern_ScalarOp fern_internal_scalar_op(fern_Box f) {
+  if(!fern_is_function(f)) {
+    return fern_ScalarOp_none;
+  }
+  fern_Function function = fern_unpack_function(f);
+  if(function->type != fern_FunctionType_c) {
+    return fern_ScalarOp_none;
+  }
+  if(function->c == fern_PLUS_SIGN_evokation0)           return fern_ScalarOp_add;
+  if(function->c == fern_MULTIPLICATION_SIGN_evokation0) return fern_ScalarOp_multiply;
+  if(function->c == fern_LEFT_CEILING_evokation0)        return fern_ScalarOp_max;
+  if(function->c == fern_LEFT_FLOOR_evokation0)          return fern_ScalarOp_min;
+  if(function->c == fern_LOGICAL_OR_evokation0)          return fern_ScalarOp_or;
+  if(function->c == fern_LOGICAL_AND_evokation0)         return fern_ScalarOp_and;
+  if(function->c == fern_NOT_EQUAL_SIGN_evokation0)      return fern_ScalarOp_not_equal;
+  if(function->c == fern_HYPHEN_MINUS_evokation)         return fern_ScalarOp_subtract;
+  if(function->c == fern_DIVISION_SIGN_evokation0)       return fern_ScalarOp_divide;
+  if(function->c == fern_EQUAL_SIGN_evokation0)          return fern_ScalarOp_equal;
+  return fern_ScalarOp_none;
+}
+
+fern_ScalarOp fern_internal_scalar_each_op(fern_Box f) {
+  if(!fern_is_function(f)) {
+    return fern_ScalarOp_none;
+  }
+  fern_Function function = fern_unpack_function(f);
+  if(function->type != fern_FunctionType_applied_c_m1 || function->applied_c_m1.m != fern_DIAERESIS_evokation0) {
+    return fern_ScalarOp_none;
+  }
+  return fern_internal_scalar_op(function->applied_c_m1.f);
+}
+
+// scalar primitives composed with ∘ ○ ⊸ ⟜ and trains are scalar too, so 𝔽 applied to every cell is the same composition
+// of scalar kernels. the steps come from the closure of 𝔽, operands renumbered as fern_ScalarProgram has them. returns false
+// when some step is not a scalar primitive or some constant is not a number
+static bool scalar_program(fern_Box f, bool monad, fern_ScalarProgram * program) {
+  program->num_consts = 0;
+  program->num_steps = 0;
+  program->result = 2;
+  if(!fern_is_function(f)) {
+    program->consts[program->num_consts++] = f.number;
+    return fern_is_number(f);
+  }
+  fern_Function function = fern_unpack_function(f);
+  if(function->type == fern_FunctionType_c) {
+    fern_ScalarOp op = fern_internal_scalar_op(f);
+    program->steps[program->num_steps++] = (fern_ScalarStep){ .op = op, .monad = monad, .x = 0, .w = monad ? 0 : 1 };
+    return op != fern_ScalarOp_none && (!monad || fern_internal_scalar_monad_op(op));
+  }
+  if(function->closure == NULL) {
+    fern_internal_compile_function(function);
+  }
+  if(function->closure == NULL) {
+    return false;
+  }
+
+  // the closure has 𝕩 𝕨 steps constants
+  fern_Closure closure = function->closure;
+  fern_Evokation evokation = monad ? fern_Evokation_monad : fern_Evokation_dyad;
+  uint32_t num_steps = closure->code[evokation].num_steps;
+  uint32_t num_consts = closure->num_consts;
+  #define _OPERAND(R) ((R) < 2 ? (R) : (R) < 2 + num_steps ? (R) + num_consts : (R) - num_steps)
+  for(uint32_t k = 0; k < num_consts; k++) {
+    if(!fern_is_number(closure->consts[k])) {
+      return false;
+    }
+    program->consts[k] = closure->consts[k].number;
+  }
+  for(uint32_t i = 0; i < num_steps; i++) {
+    const fern_ClosureStep * step = closure->code[evokation].steps + i;
+    bool step_monad = step->w == fern_CLOSURE_NONE;
+    fern_ScalarOp op = fern_internal_scalar_op(step->callee);
+    if(op == fern_ScalarOp_none || (step_monad && !fern_internal_scalar_monad_op(op))) {
+      return false;
+    }
+    program->steps[i] = (fern_ScalarStep){ .op = op, .monad = step_monad, .x = _OPERAND(step->x), .w = _OPERAND(step_monad ? step->x : step->w) };
+  }
+  program->num_consts = num_consts;
+  program->num_steps = num_steps;
+  program->result = _OPERAND(closure->code[evokation].result);
+  #undef _OPERAND
+  return true;
+}
+
+static bool lift_scalar(fern_Box f, bool monad, fern_DataReader x, fern_DataReader w, fern_Data result) {
+  fern_ScalarProgram program;
+  fern_DataReader inputs[2] = { x, monad ? x : w };
+  return scalar_program(f, monad, &program) && fern_internal_scalar_fused(&program, inputs, 2, result);
+}
+
+// lift_scalar for a whole frame of n cells, single cells alone would give a single cell
+static bool lift_cells(fern_Box f, bool monad, fern_DataReader x, fern_DataReader w, uint32_t n, fern_Data result) {
+  if(!lift_scalar(f, monad, x, w, result)) {
+    return false;
+  }
+  if(fern_read_data(result).size != n) {
+    fern_free_data(result);
+    return false;
+  }
+  return true;
+}
+
 // ============================================================================================================================================================
 
 // ˙ constant -------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_DOT_ABOVE_monad(fern_Box f, fern_Box x) {
+  return f;
+}
+static fern_Box fern_DOT_ABOVE_dyad(fern_Box f, fern_Box x, fern_Box w) {
+  return f;
+}
 static fern_Box fern_DOT_ABOVE_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
+    return fern_DOT_ABOVE_monad(f, x);
   case fern_Evokation_dyad:
-    return f;
+    return fern_DOT_ABOVE_dyad(f, x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -774,18 +2232,24 @@ static fern_Box fern_DOT_ABOVE_evokation0(fern_Evokation evokation, fern_Box f,
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Modifier1 fern_DOT_ABOVE_mod1 = { .type = fern_Modifier1Type_c, .c = fern_DOT_ABOVE_evokation0 };
+static struct fern_Modifier1 fern_DOT_ABOVE_mod1 = { .type = fern_Modifier1Type_c, .c = fern_DOT_ABOVE_evokation0, .monad = fern_DOT_ABOVE_monad, .dyad = fern_DOT_ABOVE_dyad };
 fern_Box fern_DOT_ABOVE(void) {
   return fern_pack_modifier1(&fern_DOT_ABOVE_mod1);
 }
 
 // ˜ swap -----------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_SMALL_TILDE_monad(fern_Box f, fern_Box x) {
+  return CALL_2(f, x, x);
+}
+static fern_Box fern_SMALL_TILDE_dyad(fern_Box f, fern_Box x, fern_Box w) {
+  return CALL_2(f, w, x);
+}
 static fern_Box fern_SMALL_TILDE_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
-    w = x;
+    return fern_SMALL_TILDE_monad(f, x);
   case fern_Evokation_dyad:
-    CALL_2(f, w, x);
+    return fern_SMALL_TILDE_dyad(f, x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -793,96 +2257,375 @@ static fern_Box fern_SMALL_TILDE_evokation0(fern_Evokation evokation, fern_Box f
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Modifier1 fern_SMALL_TILDE_mod1 = { .type = fern_Modifier1Type_c, .c = fern_SMALL_TILDE_evokation0 };
+static struct fern_Modifier1 fern_SMALL_TILDE_mod1 = { .type = fern_Modifier1Type_c, .c = fern_SMALL_TILDE_evokation0, .monad = fern_SMALL_TILDE_monad, .dyad = fern_SMALL_TILDE_dyad };
 fern_Box fern_SMALL_TILDE(void) {
   return fern_pack_modifier1(&fern_SMALL_TILDE_mod1);
 }
 
 // ˘ cells ----------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_DIAERESIS_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w);
+static fern_Box fern_ACUTE_ACCENT_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w);
+static fern_Box concatenate_parts(uint32_t count, const fern_Box * parts, bool couple, const char * error);
+
+// an argument split into a frame of cells of a given rank. cells are arrays whose data is a slice of the data of the
+// argument, so no cell is copied, and rank 0 cells are passed as the atom they hold
+typedef struct {
+  fern_Box        x;
+  uint32_t        frame_rank;
+  uint32_t        num_cells;
+  uint32_t        cell_size;
+  union fern_Data cell_shape;
+} CellFrame;
+
+// a rank k ≥ 0 is at most the rank of 𝕩, a rank k < 0 leaves at most -k frame axes
+static uint32_t cell_rank(uint32_t rank, int64_t k) {
+  if(k >= 0) {
+    return k < rank ? k : rank;
+  }
+  return -k < rank ? rank + k : 0;
+}
 
-// ¨ each -----------------------------------------------------------------------------------------------------------------------------------------------------
-static fern_Box fern_DIAERESIS_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w) {
-  switch(evokation) {
-  case fern_Evokation_monad:
-    if(fern_is_array(x)) {
-      fern_Array xa = fern_unpack_array(x);
-      fern_ArrayReader xar = fern_read_array(xa);
+static void cell_frame_init(CellFrame * frame, fern_Box x, int64_t k) {
+  frame->x = x;
+  if(!fern_is_array(x)) {
+    frame->frame_rank = 0;
+    frame->num_cells = 1;
+    frame->cell_size = 1;
+    return;
+  }
+  fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+  uint32_t rank = fern_array_rank(xar);
+  uint32_t cr = cell_rank(rank, k);
+  frame->frame_rank = rank - cr;
+  frame->num_cells = 1;
+  for(uint32_t i = 0; i < frame->frame_rank; i++) {
+    frame->num_cells *= fern_array_axis_length(xar, i);
+  }
+  frame->cell_size = 1;
+  uint32_t * shape = malloc(sizeof(uint32_t) * (cr ? cr : 1));
+  for(uint32_t i = 0; i < cr; i++) {
+    shape[i] = fern_array_axis_length(xar, frame->frame_rank + i);
+    frame->cell_size *= shape[i];
+  }
+  fern_init_shape(&frame->cell_shape, cr, shape);
+  free(shape);
+}
 
-      union fern_Data data;
-      fern_Box * cells = fern_init_data(&data, fern_Format_box, fern_array_rank(xar));
-      for(uint32_t i = 0; i < fern_array_rank(xar); i++) {
-        cells[i] = CALL_1(f, x);
+static fern_Box cell_frame_cell(CellFrame * frame, uint32_t index) {
+  if(!fern_is_array(frame->x)) {
+    return frame->x;
+  }
+  fern_Array xa = fern_unpack_array(frame->x);
+  fern_ArrayReader xar = fern_read_array(xa);
+  if(frame->cell_shape.is_pointer ? frame->cell_shape.pointer.size == 0 : frame->cell_shape.inplace.size == 0) {
+    return fern_array_get_cell(xar, index);
+  }
+  fern_Array cell = fern_allocate_array();
+  fern_clone_data(&cell->shape, &frame->cell_shape);
+  if((uint64_t)(index + 1) * frame->cell_size <= xar.cells.size) {
+    fern_slice_data(&cell->cells, &xa->cells, index * frame->cell_size, frame->cell_size);
+  } else {
+    fern_Box * cells = fern_init_data(&cell->cells, fern_Format_box, frame->cell_size);
+    for(uint32_t i = 0; i < frame->cell_size; i++) {
+      cells[i] = fern_array_get_cell(xar, index * frame->cell_size + i);
+    }
+  }
+  cell->fill = xar.fill;
+  return fern_pack_array(cell);
+}
+
+static void cell_frame_free(CellFrame * frame) {
+  if(fern_is_array(frame->x)) {
+    fern_free_data(&frame->cell_shape);
+  }
+}
+
+// the cells of rank k of 𝕩 as boxes, rank 0 cells as the atoms they hold
+static void boxed_cells(fern_Box x, uint32_t k, fern_Data result) {
+  CellFrame frame;
+  cell_frame_init(&frame, x, k);
+  fern_Box * cells = fern_init_data(result, fern_Format_box, frame.num_cells);
+  for(uint32_t i = 0; i < frame.num_cells; i++) {
+    cells[i] = cell_frame_cell(&frame, i);
+  }
+  cell_frame_free(&frame);
+}
+
+// the n results of 𝔽 on the cells of a frame coupled into one array, then the leading axis split back into the frame. an
+// empty frame has no results to take a cell shape from and gives rank 0 cells
+static fern_Box merge_cells(uint32_t n, const fern_Box * results, fern_ArrayReader frame, uint32_t frame_rank, const char * error) {
+  union fern_Data empty;
+  fern_init_data(&empty, fern_Format_box, 0);
+  fern_Box merged = n ? concatenate_parts(n, results, true, error) : fern_mk_array3(&empty, fern_DIGIT_ZERO());
+  fern_ArrayReader mar = fern_read_array(fern_unpack_array(merged));
+  uint32_t result_cell_rank = n ? fern_array_rank(mar) - 1 : 0;
+  uint32_t * shape = malloc(sizeof(uint32_t) * (frame_rank + result_cell_rank + 1));
+  for(uint32_t i = 0; i < frame_rank; i++) {
+    shape[i] = fern_array_axis_length(frame, i);
+  }
+  for(uint32_t i = 0; i < result_cell_rank; i++) {
+    shape[frame_rank + i] = fern_array_axis_length(mar, i + 1);
+  }
+  fern_Box result = fern_mk_array2(frame_rank + result_cell_rank, shape, &fern_unpack_array(merged)->cells, fern_array_fill(mar));
+  free(shape);
+  return result;
+}
+
+// 𝔽 on the cells of 𝕩 (and 𝕨) of ranks mr, or lr and rr, with the results merged under the longer frame. scalar 𝔽 and 𝔽´
+// of a scalar 𝔽 on rows see the whole frame at once in a single kernel call
+static fern_Box evoke_cells(fern_Box f, fern_Evokation evokation, fern_Box x, fern_Box w, int64_t mr, int64_t lr, int64_t rr, const char * error) {
+  bool monad = evokation == fern_Evokation_monad;
+  uint32_t x_rank = fern_is_array(x) ? fern_array_rank(fern_read_array(fern_unpack_array(x))) : 0;
+  uint32_t w_rank = !monad && fern_is_array(w) ? fern_array_rank(fern_read_array(fern_unpack_array(w))) : 0;
+
+  if(monad && fern_is_array(x)) {
+    fern_Array xa = fern_unpack_array(x);
+    fern_ArrayReader xar = fern_read_array(xa);
+    union fern_Data data;
+    bool complete = xar.cells.size == fern_array_num_cells(xar);
+    if(complete && lift_cells(f, true, xar.cells, xar.cells, xar.cells.size, &data)) {
+      return fern_mk_array(&xa->shape, &data, fern_DIGIT_ZERO());
+    }
+
+    uint32_t cr = cell_rank(x_rank, mr);
+    fern_Function function = fern_is_function(f) ? fern_unpack_function(f) : NULL;
+    uint32_t rows = 1;
+    for(uint32_t i = 0; i + 1 < x_rank; i++) {
+      rows *= fern_array_axis_length(xar, i);
+    }
+    if(complete && cr == 1 && function && function->type == fern_FunctionType_applied_c_m1 &&
+       function->applied_c_m1.m == fern_ACUTE_ACCENT_evokation0 &&
+       fern_internal_scalar_fold(fern_internal_scalar_op(function->applied_c_m1.f), xar.cells, rows, fern_array_axis_length(xar, x_rank - 1), &data)) {
+      uint32_t * shape = malloc(sizeof(uint32_t) * x_rank);
+      for(uint32_t i = 0; i + 1 < x_rank; i++) {
+        shape[i] = fern_array_axis_length(xar, i);
       }
-      
+      fern_Box result = fern_mk_array2(x_rank - 1, shape, &data, fern_DIGIT_ZERO());
+      free(shape);
+      return result;
+    }
+  }
+  if(!monad && cell_rank(x_rank, rr) == 0 && cell_rank(w_rank, lr) == 0) {
+    // ¨ pairs the atoms and lifts a scalar 𝔽. its result is already merged unless 𝔽 gave arrays
+    fern_Box each = fern_DIAERESIS_evokation0(evokation, f, x, w);
+    if(!fern_is_array(each)) {
+      return each;
+    }
+    fern_ArrayReader ear = fern_read_array(fern_unpack_array(each));
+    uint32_t n = fern_array_num_cells(ear);
+    fern_Box * results = malloc(sizeof(fern_Box) * (n ? n : 1));
+    bool atoms = true;
+    for(uint32_t i = 0; i < n; i++) {
+      results[i] = fern_array_get_cell(ear, i);
+      atoms &= !fern_is_array(results[i]);
+    }
+    fern_Box result = atoms ? each : merge_cells(n, results, ear, fern_array_rank(ear), error);
+    free(results);
+    return result;
+  }
+  if(!monad && fern_is_array(x) && fern_is_array(w) && fern_internal_match_shape(fern_unpack_array(x), fern_unpack_array(w))) {
+    fern_Array xa = fern_unpack_array(x);
+    fern_ArrayReader xar = fern_read_array(xa);
+    fern_ArrayReader war = fern_read_array(fern_unpack_array(w));
+    union fern_Data data;
+    uint32_t n = fern_array_num_cells(xar);
+    if(xar.cells.size == n && war.cells.size == n && lift_cells(f, false, xar.cells, war.cells, n, &data)) {
       return fern_mk_array(&xa->shape, &data, fern_DIGIT_ZERO());
     }
-    fern_fatal_error("not implemented");
-  case fern_Evokation_dyad:
-    fern_fatal_error("not implemented");
-  case fern_Evokation_write_to_backend:
-    fern_fatal_error("not implemented");
-  case fern_Evokation_inverse:
+  }
+
+  CellFrame x_frame;
+  CellFrame w_frame;
+  cell_frame_init(&x_frame, x, monad ? mr : rr);
+  cell_frame_init(&w_frame, monad ? x : w, monad ? mr : lr);
+
+  // the longer frame is the frame of the result, the other frame must be a prefix of it
+  CellFrame * outer = monad || x_frame.frame_rank >= w_frame.frame_rank ? &x_frame : &w_frame;
+  uint32_t min_frame = x_frame.frame_rank < w_frame.frame_rank ? x_frame.frame_rank : w_frame.frame_rank;
+  fern_ArrayReader outer_reader = fern_read_array(fern_unpack_array(fern_is_array(outer->x) ? outer->x : fern_EMPTY_ARRAY()));
+  for(uint32_t i = 0; !monad && i < min_frame; i++) {
+    fern_assert_fatal_error(
+        fern_array_axis_length(fern_read_array(fern_unpack_array(x)), i) == fern_array_axis_length(fern_read_array(fern_unpack_array(w)), i)
+      , error
+      );
+  }
+
+  // cells of the shorter frame repeat over the trailing frame axes of the longer one
+  uint32_t n = outer->num_cells;
+  uint32_t inner_cells = outer == &x_frame ? w_frame.num_cells : x_frame.num_cells;
+  uint32_t repeat = monad || inner_cells == 0 ? 1 : n / inner_cells;
+  fern_Box * results = malloc(sizeof(fern_Box) * (n ? n : 1));
+  for(uint32_t i = 0; i < n; i++) {
+    fern_Box x_cell = cell_frame_cell(&x_frame, outer == &x_frame ? i : i / repeat);
+    if(monad) {
+      results[i] = CALL_1(f, x_cell);
+    } else {
+      results[i] = CALL_2(f, x_cell, cell_frame_cell(&w_frame, outer == &w_frame ? i : i / repeat));
+    }
+  }
+
+  fern_Box result = merge_cells(n, results, outer_reader, outer->frame_rank, error);
+  free(results);
+
+  cell_frame_free(&x_frame);
+  cell_frame_free(&w_frame);
+  return result;
+}
+
+// 'array 𝔽˘'       -> array - 𝔽 on each major cell of 𝕩
+// 'array 𝔽˘ array' -> array - 𝔽 on matching major cells of 𝕨 and 𝕩
+static fern_Box fern_BREVE_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w) {
+  if(evokation == fern_Evokation_write_to_backend || evokation == fern_Evokation_inverse) {
     fern_fatal_error("not implemented");
   }
-  return fern_DIGIT_ZERO();
+  return evoke_cells(f, evokation, x, w, -1, -1, -1, "˘: Leading axes of 𝕨 and 𝕩 must agree and results must have the same shape");
 }
-static struct fern_Modifier1 fern_DIAERESIS_mod1 = { .type = fern_Modifier1Type_c, .c = fern_DIAERESIS_evokation0 };
-fern_Box fern_DIAERESIS(void) {
-  return fern_pack_modifier1(&fern_DIAERESIS_mod1);
+static struct fern_Modifier1 fern_BREVE_mod1 = { .type = fern_Modifier1Type_c, .c = fern_BREVE_evokation0 };
+fern_Box fern_BREVE(void) {
+  return fern_pack_modifier1(&fern_BREVE_mod1);
 }
 
-// ⌜ table ----------------------------------------------------------------------------------------------------------------------------------------------------
-static fern_Box fern_TOP_LEFT_CORNER_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w) {
-  switch(evokation) {
-  case fern_Evokation_monad:
-    if(fern_is_array(x)) {
-      fern_Array xa = fern_unpack_array(x);
-      fern_ArrayReader xar = fern_read_array(xa);
+// ¨ each -----------------------------------------------------------------------------------------------------------------------------------------------------
+// an atom is a rank 0 array of one cell
+static uint32_t frame_rank(fern_Box x) {
+  return fern_is_array(x) ? fern_array_rank(fern_read_array(fern_unpack_array(x))) : 0;
+}
+static uint32_t frame_axis_length(fern_Box x, uint32_t axis) {
+  return fern_array_axis_length(fern_read_array(fern_unpack_array(x)), axis);
+}
+static fern_Box frame_cell(fern_Box x, uint32_t index) {
+  return fern_is_array(x) ? fern_array_get_cell(fern_read_array(fern_unpack_array(x)), index) : x;
+}
+// the cells of an array, or the atom as a single boxed cell
+static fern_DataReader frame_cells(const fern_Box * x) {
+  return fern_is_array(*x)
+    ? fern_read_array(fern_unpack_array(*x)).cells
+    : (fern_DataReader) { .format = fern_Format_box, .size = 1, .box = (fern_Box *)x };
+}
+// whether every cell is stored rather than read as the fill
+static bool frame_complete(fern_Box x) {
+  return !fern_is_array(x) || fern_array_complete(fern_read_array(fern_unpack_array(x)));
+}
 
-      union fern_Data data;
-      fern_Box * cells = fern_init_data(&data, fern_Format_box, fern_array_rank(xar));
-      for(uint32_t i = 0; i < fern_array_rank(xar); i++) {
-        cells[i] = CALL_1(f, x);
+// 'any 𝔽¨'     -> array - 𝔽 applied to every cell of 𝕩
+// 'any 𝔽¨ any' -> array - 𝔽 applied to matching cells of 𝕨 and 𝕩, the shape of one must be a prefix of the shape of the other
+// scalar 𝔽 runs as whole array kernels instead
+static fern_Box fern_DIAERESIS_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w) {
+  if(evokation == fern_Evokation_write_to_backend || evokation == fern_Evokation_inverse) {
+    fern_fatal_error("not implemented");
+  }
+  bool monad = evokation == fern_Evokation_monad;
+  if(monad) {
+    w = x;
+  }
+
+  // the argument with the higher rank gives the shape of the result, the other one is repeated over its trailing axes
+  uint32_t x_rank = frame_rank(x);
+  uint32_t w_rank = frame_rank(w);
+  fern_Box frame = x_rank >= w_rank ? x : w;
+  uint32_t rank = x_rank >= w_rank ? x_rank : w_rank;
+  uint32_t min_rank = x_rank < w_rank ? x_rank : w_rank;
+  for(uint32_t k = 0; k < min_rank; k++) {
+    fern_assert_fatal_error(frame_axis_length(x, k) == frame_axis_length(w, k), "¨: Leading axes of 𝕨 and 𝕩 must agree");
+  }
+
+  uint32_t * shape = malloc(sizeof(uint32_t) * (rank ? rank : 1));
+  uint64_t size = 1;
+  uint64_t small_size = 1;
+  for(uint32_t k = 0; k < rank; k++) {
+    shape[k] = frame_axis_length(frame, k);
+    size *= shape[k];
+    small_size *= k < min_rank ? shape[k] : 1;
+  }
+
+  union fern_Data data;
+  bool complete = frame_complete(x) && frame_complete(w);
+  bool broadcast = monad || x_rank == w_rank || small_size == 1;
+  if(!(size && complete && broadcast && lift_cells(f, monad, frame_cells(&x), frame_cells(&w), size, &data))) {
+    fern_Box * cells = fern_init_data(&data, fern_Format_box, size);
+    uint64_t repeat = size / (small_size ? small_size : 1);
+    for(uint64_t i = 0; i < size; i++) {
+      fern_Box x_cell = frame_cell(x, x_rank >= w_rank ? i : i / repeat);
+      if(monad) {
+        cells[i] = CALL_1(f, x_cell);
+      } else {
+        cells[i] = CALL_2(f, x_cell, frame_cell(w, w_rank > x_rank ? i : i / repeat));
       }
-      
-      return fern_mk_array(&xa->shape, &data, fern_DIGIT_ZERO());
     }
-    fern_fatal_error("not implemented");
-  case fern_Evokation_dyad:
-    if(fern_is_array(x) && fern_is_array(w)) {
-      fern_Array xa = fern_unpack_array(x);
-      fern_ArrayReader xar = fern_read_array(xa);
+  }
+
+  fern_Box result = fern_mk_array2(rank, shape, &data, fern_DIGIT_ZERO());
+  free(shape);
+  return result;
+}
+static struct fern_Modifier1 fern_DIAERESIS_mod1 = { .type = fern_Modifier1Type_c, .c = fern_DIAERESIS_evokation0 };
+fern_Box fern_DIAERESIS(void) {
+  return fern_pack_modifier1(&fern_DIAERESIS_mod1);
+}
 
-      fern_Array wa = fern_unpack_array(w);
-      fern_ArrayReader war = fern_read_array(wa);
+// ⌜ table ----------------------------------------------------------------------------------------------------------------------------------------------------
+// 'any 𝔽⌜'     -> array - 𝔽¨
+// 'any 𝔽⌜ any' -> array - 𝔽 applied to every pair of a cell of 𝕨 and a cell of 𝕩, with shape 𝕨 ∾○≢ 𝕩
+static fern_Box fern_TOP_LEFT_CORNER_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w) {
+  switch(evokation) {
+  case fern_Evokation_monad:
+    return fern_DIAERESIS_evokation0(evokation, f, x, w);
+  case fern_Evokation_dyad:
+    {
+      uint32_t x_rank = frame_rank(x);
+      uint32_t w_rank = frame_rank(w);
+      uint32_t * shape = malloc(sizeof(uint32_t) * (w_rank + x_rank + 1));
+      uint64_t x_size = 1;
+      uint64_t w_size = 1;
+      for(uint32_t k = 0; k < w_rank; k++) {
+        shape[k] = frame_axis_length(w, k);
+        w_size *= shape[k];
+      }
+      for(uint32_t k = 0; k < x_rank; k++) {
+        shape[w_rank + k] = frame_axis_length(x, k);
+        x_size *= shape[w_rank + k];
+      }
+      fern_assert_fatal_error(x_size * w_size <= UINT32_MAX, "⌜: result too large");
 
       union fern_Data data;
-      fern_Box * cells = fern_init_data(&data, fern_Format_box, fern_array_num_cells(xar) * fern_array_num_cells(war));
-
-      for(uint32_t i = 0; i < fern_array_num_cells(war); i++) {
-        fern_Box w_cell = fern_array_get_cell(war, i);
-        for(uint32_t j = 0; j < fern_array_num_cells(xar); j++) {
-          fern_Box x_cell = fern_array_get_cell(xar, i);
-          *cells++ = CALL_2(f, x_cell, w_cell);
+      fern_DataReader x_cells = frame_cells(&x);
+      fern_DataReader w_cells = frame_cells(&w);
+      bool lifted = false;
+      if(x_size != 0 && w_size != 0 && frame_complete(x) && frame_complete(w)) {
+        fern_ScalarOp op = fern_internal_scalar_op(f);
+        if(op != fern_ScalarOp_none) {
+          lifted = fern_internal_scalar_table(op, x_cells, w_cells, &data);
+        } else {
+          // a composition runs on 𝕩 cycled and every cell of 𝕨 repeated, both the size of the table
+          union fern_Data x_table;
+          union fern_Data w_table;
+          union fern_Data repeat;
+          uint32_t * counts = fern_init_data(&repeat, fern_Format_natural_32_bit, w_size);
+          for(uint32_t i = 0; i < w_size; i++) {
+            counts[i] = x_size;
+          }
+          fern_internal_cycle(x_cells, x_size * w_size, &x_table);
+          fern_internal_replicate(fern_read_data(&repeat), w_cells, 1, &w_table);
+          lifted = lift_cells(f, false, fern_read_data(&x_table), fern_read_data(&w_table), x_size * w_size, &data);
+          fern_free_data(&repeat);
+          fern_free_data(&x_table);
+          fern_free_data(&w_table);
         }
       }
-
-      size_t new_rank = fern_array_rank(war) + fern_array_rank(xar);
-      uint32_t * shape = malloc(sizeof(*shape) * new_rank);
-      for(uint32_t i = 0; i < fern_array_rank(war); i++) {
-        shape[i] = fern_array_axis_length(war, i);
-      }
-      for(uint32_t i = fern_array_rank(war), j = 0; j < fern_array_rank(xar); i++, j++) {
-        shape[i] = fern_array_axis_length(xar, j);
+      if(!lifted) {
+        fern_Box * cells = fern_init_data(&data, fern_Format_box, x_size * w_size);
+        for(uint32_t i = 0; i < w_size; i++) {
+          fern_Box w_cell = frame_cell(w, i);
+          for(uint32_t j = 0; j < x_size; j++) {
+            *cells++ = CALL_2(f, frame_cell(x, j), w_cell);
+          }
+        }
       }
 
-      fern_Box result = fern_mk_array2(new_rank, shape, &data, fern_DIGIT_ZERO());
-      
+      fern_Box result = fern_mk_array2(w_rank + x_rank, shape, &data, fern_DIGIT_ZERO());
       free(shape);
-
       return result;
     }
-    fern_fatal_error("not implemented");
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -897,6 +2640,53 @@ fern_Box fern_TOP_LEFT_CORNER(void) {
 
 // ⁼ inverse --------------------------------------------------------------------------------------------------------------------------------------------------
 // ´ fold -----------------------------------------------------------------------------------------------------------------------------------------------------
+// 𝕩 folded from the right, x₀ 𝔽 (x₁ 𝔽 … 𝔽 xₙ₋₁) or with 𝕨 as the initial right argument. ∾´ is a single join of all the
+// parts instead of n joins that each copy everything so far
+static fern_Box fern_ACUTE_ACCENT_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w) {
+  if(evokation == fern_Evokation_write_to_backend || evokation == fern_Evokation_inverse) {
+    fern_fatal_error("not implemented");
+  }
+  if(!fern_is_array(x) || fern_array_rank(fern_read_array(fern_unpack_array(x))) != 1) {
+    fern_fatal_error("´: 𝕩 must be a list");
+  }
+  fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+  uint32_t n = fern_array_num_cells(xar);
+  bool dyad = evokation == fern_Evokation_dyad;
+
+  if(n + dyad == 0) {
+    if(fern_is_function(f) && fern_unpack_function(f)->type == fern_FunctionType_c && fern_unpack_function(f)->c == fern_INVERTED_LAZY_S_evokation0) {
+      return fern_EMPTY_ARRAY();
+    }
+    fern_ScalarOp op = fern_internal_scalar_op(f);
+    fern_assert_fatal_error(op != fern_ScalarOp_none, "´: No identity found");
+    return fern_pack_number(fern_internal_scalar_identity(op));
+  }
+
+  if(fern_is_function(f) && fern_unpack_function(f)->type == fern_FunctionType_c && fern_unpack_function(f)->c == fern_INVERTED_LAZY_S_evokation0 && n + dyad > 1) {
+    fern_Box * parts = malloc(sizeof(fern_Box) * (n + dyad));
+    for(uint32_t i = 0; i < n; i++) {
+      parts[i] = fern_array_get_cell(xar, i);
+    }
+    if(dyad) {
+      parts[n] = w;
+    }
+    fern_Box result = concatenate_parts(n + dyad, parts, false, "∾: Ranks of 𝕨 and 𝕩 must differ by at most 1 and their cell shapes must agree");
+    free(parts);
+    return result;
+  }
+
+  uint32_t i = n;
+  fern_Box result = dyad ? w : fern_array_get_cell(xar, --i);
+  while(i-- > 0) {
+    result = CALL_2(f, result, fern_array_get_cell(xar, i));
+  }
+  return result;
+}
+static struct fern_Modifier1 fern_ACUTE_ACCENT_mod1 = { .type = fern_Modifier1Type_c, .c = fern_ACUTE_ACCENT_evokation0 };
+fern_Box fern_ACUTE_ACCENT(void) {
+  return fern_pack_modifier1(&fern_ACUTE_ACCENT_mod1);
+}
+
 // ˝ insert ---------------------------------------------------------------------------------------------------------------------------------------------------
 // ` scan -----------------------------------------------------------------------------------------------------------------------------------------------------
 static fern_Box fern_GRAVE_ACCENT_evokation0(fern_Evokation evokation, fern_Box f, fern_Box x, fern_Box w) {
@@ -913,7 +2703,7 @@ static fern_Box fern_GRAVE_ACCENT_evokation0(fern_Evokation evokation, fern_Box
   fern_Array xa = fern_unpack_array(x);
   fern_ArrayReader xar = fern_read_array(xa);
 
-  fern_Array wa;
+  fern_Array wa = NULL;
   struct fern_Array w_singleton;
 
   if(evokation == fern_Evokation_dyad) {
@@ -948,23 +2738,42 @@ static fern_Box fern_GRAVE_ACCENT_evokation0(fern_Evokation evokation, fern_Box
     return fern_EMPTY_ARRAY();
   }
 
-  union fern_Data cells;
-  fern_Box * result = fern_init_data(&cells, fern_Format_box, l);
-
   uint32_t c = 1;
   for(uint32_t i = 1; i < fern_array_rank(xar); i++) {
     c *= fern_array_axis_length(xar, i);
   }
 
+  union fern_Data cells;
+
+  // + × ⌈ ⌊ ∨ ∧ ≠ have kernels over the native format of 𝕩, scanning a whole major cell of c contiguous cells at a time
+  fern_ScalarOp op = fern_internal_scalar_op(f);
+  if(op != fern_ScalarOp_none && l == xar.cells.size) {
+    fern_Box * seed = NULL;
+    if(evokation == fern_Evokation_dyad) {
+      fern_ArrayReader war = fern_read_array(wa);
+      seed = malloc(sizeof(*seed) * c);
+      for(uint32_t i = 0; i < c; i++) {
+        seed[i] = fern_array_get_cell(war, i);
+      }
+    }
+    bool scanned = fern_internal_scan(op, xar.cells, c, seed, &cells);
+    free(seed);
+    if(scanned) {
+      return fern_mk_array(&xa->shape, &cells, fern_array_fill(xar));
+    }
+  }
+
+  fern_Box * result = fern_init_data(&cells, fern_Format_box, l);
+
   uint32_t i;
   if(evokation == fern_Evokation_dyad) {
     fern_ArrayReader war = fern_read_array(wa);
     
-    for(i = 0; c; i++) {
+    for(i = 0; i < c; i++) {
       result[i] = CALL_2(f, fern_array_get_cell(xar, i), fern_array_get_cell(war, i));
     }
   } else {
-    for(i = 0; c; i++) {
+    for(i = 0; i < c; i++) {
       result[i] = fern_array_get_cell(xar, i);
     }
   }
@@ -981,11 +2790,18 @@ fern_Box fern_GRAVE_ACCENT(void) {
 }
 
 // ∘ atop -----------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_RING_OPERATOR_monad(fern_Box f, fern_Box g, fern_Box x) {
+  return CALL_1(f, CALL_1(g, x));
+}
+static fern_Box fern_RING_OPERATOR_dyad(fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
+  return CALL_1(f, CALL_2(g, x, w));
+}
 static fern_Box fern_RING_OPERATOR_evokation0(fern_Evokation evokation, fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
+    return fern_RING_OPERATOR_monad(f, g, x);
   case fern_Evokation_dyad:
-    return CALL_1(f, fern_evoke(g, evokation, x, w));
+    return fern_RING_OPERATOR_dyad(f, g, x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -993,18 +2809,24 @@ static fern_Box fern_RING_OPERATOR_evokation0(fern_Evokation evokation, fern_Box
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Modifier2 fern_RING_OPERATOR_mod2 = { .type = fern_Modifier2Type_c, .c = fern_RING_OPERATOR_evokation0 };
+static struct fern_Modifier2 fern_RING_OPERATOR_mod2 = { .type = fern_Modifier2Type_c, .c = fern_RING_OPERATOR_evokation0, .monad = fern_RING_OPERATOR_monad, .dyad = fern_RING_OPERATOR_dyad };
 fern_Box fern_RING_OPERATOR(void) {
   return fern_pack_modifier2(&fern_RING_OPERATOR_mod2);
 }
 
 // ○ over -----------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_WHITE_CIRCLE_monad(fern_Box f, fern_Box g, fern_Box x) {
+  return CALL_1(f, CALL_1(g, x));
+}
+static fern_Box fern_WHITE_CIRCLE_dyad(fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
+  return CALL_2(f, CALL_1(g, x), CALL_1(g, w));
+}
 static fern_Box fern_WHITE_CIRCLE_evokation0(fern_Evokation evokation, fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
-    return CALL_1(f, CALL_1(g, x));
+    return fern_WHITE_CIRCLE_monad(f, g, x);
   case fern_Evokation_dyad:
-    return CALL_2(f, CALL_1(g, x), CALL_1(g, w));
+    return fern_WHITE_CIRCLE_dyad(f, g, x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -1012,18 +2834,24 @@ static fern_Box fern_WHITE_CIRCLE_evokation0(fern_Evokation evokation, fern_Box
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Modifier2 fern_WHITE_CIRCLE_mod2 = { .type = fern_Modifier2Type_c, .c = fern_WHITE_CIRCLE_evokation0 };
+static struct fern_Modifier2 fern_WHITE_CIRCLE_mod2 = { .type = fern_Modifier2Type_c, .c = fern_WHITE_CIRCLE_evokation0, .monad = fern_WHITE_CIRCLE_monad, .dyad = fern_WHITE_CIRCLE_dyad };
 fern_Box fern_WHITE_CIRCLE(void) {
   return fern_pack_modifier2(&fern_WHITE_CIRCLE_mod2);
 }
 
 // ⊸ before ---------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_MULTIMAP_monad(fern_Box f, fern_Box g, fern_Box x) {
+  return CALL_2(g, x, CALL_1(f, x));
+}
+static fern_Box fern_MULTIMAP_dyad(fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
+  return CALL_2(g, x, CALL_1(f, w));
+}
 static fern_Box fern_MULTIMAP_evokation0(fern_Evokation evokation, fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
-    w = x;
+    return fern_MULTIMAP_monad(f, g, x);
   case fern_Evokation_dyad:
-    return CALL_2(g, x, CALL_1(f, w));
+    return fern_MULTIMAP_dyad(f, g, x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -1031,18 +2859,24 @@ static fern_Box fern_MULTIMAP_evokation0(fern_Evokation evokation, fern_Box f, f
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Modifier2 fern_MULTIMAP_mod2 = { .type = fern_Modifier2Type_c, .c = fern_MULTIMAP_evokation0 };
+static struct fern_Modifier2 fern_MULTIMAP_mod2 = { .type = fern_Modifier2Type_c, .c = fern_MULTIMAP_evokation0, .monad = fern_MULTIMAP_monad, .dyad = fern_MULTIMAP_dyad };
 fern_Box fern_MULTIMAP(void) {
   return fern_pack_modifier2(&fern_MULTIMAP_mod2);
 }
 
 // ⟜ after ----------------------------------------------------------------------------------------------------------------------------------------------------
+static fern_Box fern_LEFT_MULTIMAP_monad(fern_Box f, fern_Box g, fern_Box x) {
+  return CALL_2(f, CALL_1(g, x), x);
+}
+static fern_Box fern_LEFT_MULTIMAP_dyad(fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
+  return CALL_2(f, CALL_1(g, x), w);
+}
 static fern_Box fern_LEFT_MULTIMAP_evokation0(fern_Evokation evokation, fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
   switch(evokation) {
   case fern_Evokation_monad:
-    w = x;
+    return fern_LEFT_MULTIMAP_monad(f, g, x);
   case fern_Evokation_dyad:
-    return CALL_2(f, CALL_1(g, x), w);
+    return fern_LEFT_MULTIMAP_dyad(f, g, x, w);
   case fern_Evokation_write_to_backend:
     fern_fatal_error("not implemented");
   case fern_Evokation_inverse:
@@ -1050,12 +2884,531 @@ static fern_Box fern_LEFT_MULTIMAP_evokation0(fern_Evokation evokation, fern_Box
   }
   return fern_DIGIT_ZERO();
 }
-static struct fern_Modifier2 fern_LEFT_MULTIMAP_mod2 = { .type = fern_Modifier2Type_c, .c = fern_LEFT_MULTIMAP_evokation0 };
+static struct fern_Modifier2 fern_LEFT_MULTIMAP_mod2 = { .type = fern_Modifier2Type_c, .c = fern_LEFT_MULTIMAP_evokation0, .monad = fern_LEFT_MULTIMAP_monad, .dyad = fern_LEFT_MULTIMAP_dyad };
 fern_Box fern_LEFT_MULTIMAP(void) {
   return fern_pack_modifier2(&fern_LEFT_MULTIMAP_mod2);
 }
 
+// idioms -----------------------------------------------------------------------------------------------------------------------------------------------------
+// derived functions that have a one pass kernel in place of composing the general implementations. they are recognized
+// once, when the modifier is applied, by the identity of the modifier and its primitive operands, and the kernel is set as
+// the direct entry point of the applied function. a kernel falls back to the general implementation for arguments it
+// does not cover
+
+// 𝔽´ of a list of numbers for scalar 𝔽
+static fern_Box idiom_fold_scalar(fern_Box f, fern_Box x) {
+  if(fern_is_array(x)) {
+    fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+    uint32_t n = xar.cells.size;
+    union fern_Data data;
+    if(fern_array_rank(xar) == 1 && n == fern_array_num_cells(xar)
+       && fern_internal_scalar_fold(fern_internal_scalar_op(f), xar.cells, 1, n, &data)) {
+      fern_Box result = fern_data_get_cell(fern_read_data(&data), 0);
+      fern_free_data(&data);
+      return result;
+    }
+  }
+  return fern_ACUTE_ACCENT_evokation0(fern_Evokation_monad, f, x, fern_nil());
+}
+
+// ≠¨ as the lengths of the cells of 𝕩 as naturals, all ones when no cell is an array
+static fern_Box idiom_each_length(fern_Box f, fern_Box x) {
+  if(!fern_is_array(x)) {
+    return fern_DIAERESIS_evokation0(fern_Evokation_monad, f, x, fern_nil());
+  }
+  fern_Array xa = fern_unpack_array(x);
+  fern_ArrayReader xar = fern_read_array(xa);
+  uint32_t l = fern_array_num_cells(xar);
+
+  union fern_Data data;
+  if(xar.cells.format != fern_Format_box && xar.cells.size == l) {
+    fern_internal_fill_cells(fern_init_data(&data, fern_Format_natural_1_bit, l), fern_Format_natural_1_bit, 0, l, fern_DIGIT_ONE());
+  } else {
+    uint32_t * lengths = fern_init_data(&data, fern_Format_natural_32_bit, l);
+    for(uint32_t i = 0; i < l; i++) {
+      fern_Box cell = fern_array_get_cell(xar, i);
+      lengths[i] = fern_is_array(cell) ? fern_array_axis_length(fern_read_array(fern_unpack_array(cell)), 0) : 1;
+    }
+  }
+  return fern_mk_array(&xa->shape, &data, fern_DIGIT_ZERO());
+}
+
+// ⊐˜ searching the list 𝕩 in itself, or 𝕨 in 𝕩
+static fern_Box idiom_self_index_of_monad(fern_Box f, fern_Box x) {
+  return search_cells(fern_Search_index_of, x, x, false, "⊐: 𝕨 must have rank at least 1", "⊐: Rank of 𝕩 must be at least the cell rank of 𝕨");
+}
+static fern_Box idiom_self_index_of_dyad(fern_Box f, fern_Box x, fern_Box w) {
+  return search_cells(fern_Search_index_of, x, w, false, "⊐: 𝕨 must have rank at least 1", "⊐: Rank of 𝕩 must be at least the cell rank of 𝕨");
+}
+
+// ⊑∘⍋ and ⊑∘⍒ as the index of the first smallest or largest cell of a list, one pass instead of a grade
+static fern_Box idiom_first_grade(fern_Box f, fern_Box g, fern_Box x, bool down) {
+  if(fern_is_array(x)) {
+    fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+    uint32_t n = xar.cells.size;
+    if(fern_array_rank(xar) == 1 && n != 0 && n == fern_array_num_cells(xar)) {
+      uint32_t best = 0;
+      fern_Box best_cell = fern_data_get_cell(xar.cells, 0);
+      for(uint32_t i = 1; i < n; i++) {
+        fern_Box cell = fern_data_get_cell(xar.cells, i);
+        int order = fern_is_number(cell) && fern_is_number(best_cell)
+          ? (cell.number < best_cell.number ? -1 : cell.number > best_cell.number)
+          : fern_internal_compare(cell, best_cell);
+        if(down ? order > 0 : order < 0) {
+          best = i;
+          best_cell = cell;
+        }
+      }
+      return fern_pack_number(best);
+    }
+  }
+  return fern_RING_OPERATOR_monad(f, g, x);
+}
+static fern_Box idiom_first_grade_up(fern_Box f, fern_Box g, fern_Box x) {
+  return idiom_first_grade(f, g, x, false);
+}
+static fern_Box idiom_first_grade_down(fern_Box f, fern_Box g, fern_Box x) {
+  return idiom_first_grade(f, g, x, true);
+}
+
+// /○⥊ on the cells of 𝕩 (and 𝕨) directly, without making the lists
+static fern_Box idiom_replicate_ravel_monad(fern_Box f, fern_Box g, fern_Box x) {
+  if(fern_is_array(x) && frame_complete(x)) {
+    union fern_Data data;
+    fern_internal_indices(fern_read_array(fern_unpack_array(x)).cells, &data);
+    return fern_mk_array3(&data, fern_DIGIT_ZERO());
+  }
+  return fern_WHITE_CIRCLE_monad(f, g, x);
+}
+static fern_Box idiom_replicate_ravel_dyad(fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
+  if(fern_is_array(x) && fern_is_array(w) && frame_complete(x) && frame_complete(w)) {
+    fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+    fern_ArrayReader war = fern_read_array(fern_unpack_array(w));
+    if(war.cells.size == xar.cells.size) {
+      union fern_Data data;
+      uint32_t length = fern_internal_replicate(war.cells, xar.cells, 1, &data);
+      return fern_mk_array2(1, &length, &data, fern_array_fill(xar));
+    }
+  }
+  return fern_WHITE_CIRCLE_dyad(f, g, x, w);
+}
+
+static const struct {
+  fern_Modifier1Evokation m;
+  const struct fern_Function * f;
+  fern_Modifier1Monad monad;
+  fern_Modifier1Dyad dyad;
+} m1_idioms[] = {
+    { fern_ACUTE_ACCENT_evokation0, &fern_PLUS_SIGN_fn,             idiom_fold_scalar,         NULL                      }
+  , { fern_ACUTE_ACCENT_evokation0, &fern_HYPHEN_MINUS_fn,          idiom_fold_scalar,         NULL                      }
+  , { fern_ACUTE_ACCENT_evokation0, &fern_MULTIPLICATION_SIGN_fn,   idiom_fold_scalar,         NULL                      }
+  , { fern_ACUTE_ACCENT_evokation0, &fern_DIVISION_SIGN_fn,         idiom_fold_scalar,         NULL                      }
+  , { fern_ACUTE_ACCENT_evokation0, &fern_LEFT_FLOOR_fn,            idiom_fold_scalar,         NULL                      }
+  , { fern_ACUTE_ACCENT_evokation0, &fern_LEFT_CEILING_fn,          idiom_fold_scalar,         NULL                      }
+  , { fern_ACUTE_ACCENT_evokation0, &fern_LOGICAL_AND_fn,           idiom_fold_scalar,         NULL                      }
+  , { fern_ACUTE_ACCENT_evokation0, &fern_LOGICAL_OR_fn,            idiom_fold_scalar,         NULL                      }
+  , { fern_ACUTE_ACCENT_evokation0, &fern_EQUAL_SIGN_fn,            idiom_fold_scalar,         NULL                      }
+  , { fern_ACUTE_ACCENT_evokation0, &fern_NOT_EQUAL_SIGN_fn,        idiom_fold_scalar,         NULL                      }
+  , { fern_DIAERESIS_evokation0,    &fern_NOT_EQUAL_SIGN_fn,        idiom_each_length,         NULL                      }
+  , { fern_SMALL_TILDE_evokation0,  &fern_SQUARE_ORIGINAL_OF_fn,    idiom_self_index_of_monad, idiom_self_index_of_dyad  }
+};
+
+static const struct {
+  fern_Modifier2Evokation m;
+  const struct fern_Function * f;
+  const struct fern_Function * g;
+  fern_Modifier2Monad monad;
+  fern_Modifier2Dyad dyad;
+} m2_idioms[] = {
+    { fern_RING_OPERATOR_evokation0, &fern_SQUARE_IMAGE_OF_OR_EQUAL_TO_fn, &fern_APL_FUNCTIONAL_SYMBOL_DELTA_STILE_fn,    idiom_first_grade_up,        NULL                       }
+  , { fern_RING_OPERATOR_evokation0, &fern_SQUARE_IMAGE_OF_OR_EQUAL_TO_fn, &fern_APL_FUNCTIONAL_SYMBOL_DEL_STILE_fn,      idiom_first_grade_down,      NULL                       }
+  , { fern_WHITE_CIRCLE_evokation0,  &fern_SOLIDUS_fn,                     &fern_LEFT_BARB_UP_RIGHT_BARB_DOWN_HARPOON_fn, idiom_replicate_ravel_monad, idiom_replicate_ravel_dyad }
+};
+
+// the primitive behind an operand, NULL for anything else
+static const struct fern_Function * idiom_operand(fern_Box f) {
+  return fern_is_function(f) && fern_unpack_function(f)->type == fern_FunctionType_c ? fern_unpack_function(f) : NULL;
+}
+
+// the index in m1_idioms or m2_idioms of an applied function, -1 when it is no idiom
+static int32_t idiom_lookup(fern_Function function) {
+  if(function->type == fern_FunctionType_applied_c_m1) {
+    const struct fern_Function * f = idiom_operand(function->applied_c_m1.f);
+    for(uint32_t i = 0; f && i < sizeof(m1_idioms) / sizeof(m1_idioms[0]); i++) {
+      if(m1_idioms[i].m == function->applied_c_m1.m && m1_idioms[i].f == f) {
+        return i;
+      }
+    }
+  }
+  if(function->type == fern_FunctionType_applied_c_m2) {
+    const struct fern_Function * f = idiom_operand(function->applied_c_m2.f);
+    const struct fern_Function * g = idiom_operand(function->applied_c_m2.g);
+    for(uint32_t i = 0; f && g && i < sizeof(m2_idioms) / sizeof(m2_idioms[0]); i++) {
+      if(m2_idioms[i].m == function->applied_c_m2.m && m2_idioms[i].f == f && m2_idioms[i].g == g) {
+        return i;
+      }
+    }
+  }
+  return -1;
+}
+
+static bool catch_recognize(fern_Function function);
+
+bool fern_internal_recognize_idiom(fern_Function function) {
+  if(catch_recognize(function)) {
+    return true;
+  }
+  int32_t i = idiom_lookup(function);
+  if(i < 0) {
+    return false;
+  }
+  if(function->type == fern_FunctionType_applied_c_m1) {
+    function->applied_c_m1.monad = m1_idioms[i].monad ? m1_idioms[i].monad : function->applied_c_m1.monad;
+    function->applied_c_m1.dyad = m1_idioms[i].dyad ? m1_idioms[i].dyad : function->applied_c_m1.dyad;
+  } else {
+    function->applied_c_m2.monad = m2_idioms[i].monad ? m2_idioms[i].monad : function->applied_c_m2.monad;
+    function->applied_c_m2.dyad = m2_idioms[i].dyad ? m2_idioms[i].dyad : function->applied_c_m2.dyad;
+  }
+  return true;
+}
+
+// closures ---------------------------------------------------------------------------------------------------------------------------------------------------
+// trains and ∘ ○ ⊸ ⟜ are inlined into the steps of their parent, anything else is one step, idioms included. constants are
+// numbered from 0x80 while building, since their registers are only known once the number of steps is
+typedef struct {
+  fern_Closure closure;
+  fern_Evokation evokation;
+  bool full;
+} ClosureBuilder;
+
+static uint8_t closure_emit(ClosureBuilder * b, fern_Box f, uint8_t x, uint8_t w);
+
+static uint8_t closure_step(ClosureBuilder * b, fern_FunctionEvokation c, fern_Box callee, uint8_t x, uint8_t w) {
+  uint32_t * num_steps = &b->closure->code[b->evokation].num_steps;
+  if(*num_steps == fern_CLOSURE_MAX) {
+    b->full = true;
+    return 0;
+  }
+  fern_ClosureStep step = { .c = c, .callee = callee, .x = x, .w = w };
+  if(c != NULL && w == fern_CLOSURE_NONE) {
+    step.monad = fern_unpack_function(callee)->monad;
+  } else if(c != NULL) {
+    step.dyad = fern_unpack_function(callee)->dyad;
+  }
+  b->closure->code[b->evokation].steps[*num_steps] = step;
+  return 2 + (*num_steps)++;
+}
+
+static uint8_t closure_const(ClosureBuilder * b, fern_Box value) {
+  fern_Closure closure = b->closure;
+  uint32_t i = 0;
+  while(i < closure->num_consts && closure->consts[i].bits != value.bits) {
+    i++;
+  }
+  if(i == fern_CLOSURE_MAX) {
+    b->full = true;
+    return 0;
+  }
+  if(i == closure->num_consts) {
+    closure->consts[closure->num_consts++] = value;
+  }
+  return 0x80 | i;
+}
+
+static uint8_t closure_emit(ClosureBuilder * b, fern_Box f, uint8_t x, uint8_t w) {
+  if(!fern_is_function(f)) {
+    return closure_const(b, f);
+  }
+  fern_Function function = fern_unpack_function(f);
+  bool monad = w == fern_CLOSURE_NONE;
+  switch(function->type) {
+  case fern_FunctionType_c:
+    return closure_step(b, function->c, f, x, w);
+  case fern_FunctionType_train2:
+    return closure_emit(b, function->train2.g, closure_emit(b, function->train2.h, x, w), fern_CLOSURE_NONE);
+  case fern_FunctionType_train3:
+    {
+      uint8_t right = closure_emit(b, function->train3.h, x, w);
+      uint8_t left = closure_emit(b, function->train3.f, x, w);
+      return closure_emit(b, function->train3.g, right, left);
+    }
+  case fern_FunctionType_applied_c_m2:
+    if(idiom_lookup(function) < 0) {
+      fern_Modifier2Evokation m = function->applied_c_m2.m;
+      fern_Box mf = function->applied_c_m2.f;
+      fern_Box mg = function->applied_c_m2.g;
+      if(m == fern_RING_OPERATOR_evokation0) {
+        return closure_emit(b, mf, closure_emit(b, mg, x, w), fern_CLOSURE_NONE);
+      }
+      if(m == fern_WHITE_CIRCLE_evokation0) {
+        uint8_t gx = closure_emit(b, mg, x, fern_CLOSURE_NONE);
+        return closure_emit(b, mf, gx, monad ? fern_CLOSURE_NONE : closure_emit(b, mg, w, fern_CLOSURE_NONE));
+      }
+      if(m == fern_MULTIMAP_evokation0) {
+        return closure_emit(b, mg, x, closure_emit(b, mf, monad ? x : w, fern_CLOSURE_NONE));
+      }
+      if(m == fern_LEFT_MULTIMAP_evokation0) {
+        return closure_emit(b, mf, closure_emit(b, mg, x, fern_CLOSURE_NONE), monad ? x : w);
+      }
+    }
+    // fall through
+  default:
+    return closure_step(b, NULL, f, x, w);
+  }
+}
+
+static uint8_t closure_register(fern_Closure closure, fern_Evokation evokation, uint8_t r) {
+  return r != fern_CLOSURE_NONE && r & 0x80 ? 2 + closure->code[evokation].num_steps + (r & 0x7f) : r;
+}
+
+void fern_internal_compile_function(fern_Function function) {
+  if(idiom_lookup(function) >= 0) {
+    return;
+  }
+  if(function->type != fern_FunctionType_train2 && function->type != fern_FunctionType_train3
+     && !(function->type == fern_FunctionType_applied_c_m2 && (
+          function->applied_c_m2.m == fern_RING_OPERATOR_evokation0
+       || function->applied_c_m2.m == fern_WHITE_CIRCLE_evokation0
+       || function->applied_c_m2.m == fern_MULTIMAP_evokation0
+       || function->applied_c_m2.m == fern_LEFT_MULTIMAP_evokation0))) {
+    return;
+  }
+  // built in scratch space of the largest size, then copied into one allocation of the size it needs
+  fern_Box consts[fern_CLOSURE_MAX];
+  fern_ClosureStep steps[2][fern_CLOSURE_MAX];
+  struct fern_Closure scratch = { .num_consts = 0, .consts = consts, .code = { { .steps = steps[0] }, { .steps = steps[1] } } };
+  ClosureBuilder b = { .closure = &scratch, .full = false };
+  for(b.evokation = fern_Evokation_monad; b.evokation <= fern_Evokation_dyad; b.evokation++) {
+    scratch.code[b.evokation].num_steps = 0;
+    scratch.code[b.evokation].result = closure_emit(&b, fern_pack_function(function), 0, b.evokation == fern_Evokation_dyad ? 1 : fern_CLOSURE_NONE);
+  }
+  if(b.full) {
+    return;
+  }
+  for(fern_Evokation e = fern_Evokation_monad; e <= fern_Evokation_dyad; e++) {
+    for(uint32_t i = 0; i < scratch.code[e].num_steps; i++) {
+      scratch.code[e].steps[i].x = closure_register(&scratch, e, scratch.code[e].steps[i].x);
+      scratch.code[e].steps[i].w = closure_register(&scratch, e, scratch.code[e].steps[i].w);
+    }
+    scratch.code[e].result = closure_register(&scratch, e, scratch.code[e].result);
+  }
+
+  uint32_t num_monad = scratch.code[fern_Evokation_monad].num_steps;
+  uint32_t num_dyad = scratch.code[fern_Evokation_dyad].num_steps;
+  fern_Closure closure = malloc(sizeof(*closure) + sizeof(fern_Box) * scratch.num_consts + sizeof(fern_ClosureStep) * (num_monad + num_dyad));
+  *closure = scratch;
+  closure->consts = (fern_Box *)(closure + 1);
+  closure->code[fern_Evokation_monad].steps = (fern_ClosureStep *)(closure->consts + scratch.num_consts);
+  closure->code[fern_Evokation_dyad].steps = closure->code[fern_Evokation_monad].steps + num_monad;
+  memcpy(closure->consts, consts, sizeof(fern_Box) * scratch.num_consts);
+  memcpy(closure->code[fern_Evokation_monad].steps, steps[fern_Evokation_monad], sizeof(fern_ClosureStep) * num_monad);
+  memcpy(closure->code[fern_Evokation_dyad].steps, steps[fern_Evokation_dyad], sizeof(fern_ClosureStep) * num_dyad);
+  function->closure = closure;
+}
+
+fern_Box fern_evoke_closure(fern_Closure closure, fern_Evokation evokation, fern_Box x, fern_Box w) {
+  fern_Box registers[2 + 2 * fern_CLOSURE_MAX];
+  uint32_t num_steps = closure->code[evokation].num_steps;
+  const fern_ClosureStep * steps = closure->code[evokation].steps;
+  registers[0] = x;
+  registers[1] = w;
+  memcpy(registers + 2 + num_steps, closure->consts, sizeof(fern_Box) * closure->num_consts);
+  for(uint32_t i = 0; i < num_steps; i++) {
+    const fern_ClosureStep * step = steps + i;
+    bool monad = step->w == fern_CLOSURE_NONE;
+    fern_Box sx = registers[step->x];
+    if(monad && step->monad) {
+      registers[2 + i] = step->monad(sx);
+    } else if(!monad && step->dyad) {
+      registers[2 + i] = step->dyad(sx, registers[step->w]);
+    } else {
+      fern_Evokation e = monad ? fern_Evokation_monad : fern_Evokation_dyad;
+      fern_Box sw = monad ? fern_nil() : registers[step->w];
+      registers[2 + i] = step->c ? step->c(e, sx, sw) : fern_evoke(step->callee, e, sx, sw);
+    }
+  }
+  return registers[closure->code[evokation].result];
+}
+
 // ⌾ under ----------------------------------------------------------------------------------------------------------------------------------------------------
+// structural 𝔾 as the part of 𝕩 it selects, 𝔾 𝕩 being `count` runs of `stride` cells of 𝕩 each starting at a major cell
+// in `positions`. the shape is that of 𝔾 𝕩, which is a single cell itself when `atom` is set
+typedef struct {
+  uint32_t *      positions;
+  uint32_t        count;
+  uint32_t        stride;
+  bool            atom;
+  union fern_Data shape;
+} UnderStructure;
+
+// recognizes ⊏ ⊑ ⌽ and i⊸⊏ i⊸⊑ m⊸/ for a boolean list m, returns false for anything else
+static bool under_structure(fern_Box g, fern_Box x, UnderStructure * s) {
+  if(!fern_is_function(g) || !fern_is_array(x)) {
+    return false;
+  }
+  fern_Function function = fern_unpack_function(g);
+  fern_Box left = fern_nothing();
+  if(function->type == fern_FunctionType_applied_c_m2 && function->applied_c_m2.m == fern_MULTIMAP_evokation0) {
+    left = fern_is_function(function->applied_c_m2.f) ? CALL_1(function->applied_c_m2.f, x) : function->applied_c_m2.f;
+    g = function->applied_c_m2.g;
+    if(!fern_is_function(g)) {
+      return false;
+    }
+    function = fern_unpack_function(g);
+  }
+  if(function->type != fern_FunctionType_c) {
+    return false;
+  }
+  bool monad = fern_internal_match(left, fern_nothing());
+
+  fern_ArrayReader xar = fern_read_array(fern_unpack_array(x));
+  uint32_t rank = fern_array_rank(xar);
+  if(rank == 0 || xar.cells.size != fern_array_num_cells(xar)) {
+    return false;
+  }
+  uint32_t n = fern_array_axis_length(xar, 0);
+  uint32_t * shape = malloc(sizeof(uint32_t) * (rank + 1));
+  uint32_t frame_rank = 1;
+  s->stride = n ? xar.cells.size / n : 0;
+  s->atom = false;
+
+  if(function->c == fern_SQUARE_IMAGE_OF_evokation0) {
+    // the major cells at the indices in i, with shape (≢i) ∾ 1↓≢𝕩
+    fern_Box i = monad ? fern_DIGIT_ZERO() : left;
+    fern_ArrayReader iar = fern_is_array(i) ? fern_read_array(fern_unpack_array(i)) : xar;
+    fern_DataReader indices = fern_is_array(i)
+      ? iar.cells
+      : (fern_DataReader) { .format = fern_Format_box, .size = 1, .box = &i };
+    frame_rank = fern_is_array(i) ? fern_array_rank(iar) : 0;
+    for(uint32_t k = 0; k < frame_rank; k++) {
+      shape[k] = fern_array_axis_length(iar, k);
+    }
+    s->positions = fern_internal_select_indices(indices, n);
+    s->count = indices.size;
+  } else if(function->c == fern_SQUARE_IMAGE_OF_OR_EQUAL_TO_evokation0) {
+    // one cell, the first of the ravel or the one a number picks from a list as ⊑ does. an index per axis is left to the
+    // general ⌾
+    if(!monad && fern_is_array(left)) {
+      free(shape);
+      return false;
+    }
+    fern_assert_fatal_error(!monad || xar.cells.size > 0, "⊑: Argument cannot be empty");
+    s->positions = malloc(sizeof(uint32_t));
+    s->positions[0] = monad ? 0 : pick_index(xar, left);
+    s->count = 1;
+    s->stride = 1;
+    s->atom = true;
+    frame_rank = 0;
+    rank = 1;
+  } else if(function->c == fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STILE_evokation0 && monad) {
+    s->positions = malloc(sizeof(uint32_t) * (n ? n : 1));
+    for(uint32_t k = 0; k < n; k++) {
+      s->positions[k] = n - 1 - k;
+    }
+    s->count = n;
+    shape[0] = n;
+  } else if(function->c == fern_SOLIDUS_evokation0 && !monad && fern_is_array(left)) {
+    fern_ArrayReader mar = fern_read_array(fern_unpack_array(left));
+    if(fern_array_rank(mar) != 1 || mar.cells.size != n || fern_internal_cell_format(mar.cells) != fern_Format_natural_1_bit) {
+      free(shape);
+      return false;
+    }
+    union fern_Data indices;
+    fern_internal_indices(mar.cells, &indices);
+    fern_DataReader ir = fern_read_data(&indices);
+    s->positions = malloc(sizeof(uint32_t) * (ir.size ? ir.size : 1));
+    for(uint32_t k = 0; k < ir.size; k++) {
+      s->positions[k] = fern_data_get_natural(ir, k);
+    }
+    s->count = ir.size;
+    shape[0] = ir.size;
+    fern_free_data(&indices);
+  } else {
+    free(shape);
+    return false;
+  }
+
+  for(uint32_t k = 1; k < rank; k++) {
+    shape[frame_rank + k - 1] = fern_array_axis_length(xar, k);
+  }
+  fern_init_shape(&s->shape, frame_rank + rank - 1, shape);
+  free(shape);
+  return true;
+}
+
+// 'any 𝔽⌾𝔾 array'     -> array - 𝕩 with the part 𝔾 selects replaced by 𝔽 of it
+// 'any 𝔽⌾𝔾 array any' -> array - 𝕩 with the part 𝔾 selects replaced by '(𝔾 𝕩) 𝔽 𝔾 𝕨'
+// only structural 𝔾 is supported. the new cells are written into a single copy of 𝕩, or straight into 𝕩 when the VM
+// hands over ownership of it
+static fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_JOT_evokation0(fern_Evokation evokation, fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
+  if(evokation == fern_Evokation_write_to_backend || evokation == fern_Evokation_inverse) {
+    fern_fatal_error("not implemented");
+  }
+  UnderStructure s;
+  if(!under_structure(g, x, &s)) {
+    fern_fatal_error("⌾: 𝔾 must be structural, 𝔾⁼ is not implemented");
+  }
+  fern_Array xa = fern_unpack_array(x);
+  fern_ArrayReader xar = fern_read_array(xa);
+
+  // 𝔾 𝕩 is gathered once and the positions are kept for the write back
+  fern_Box part;
+  if(s.atom) {
+    part = fern_data_get_cell(xar.cells, s.positions[0]);
+  } else {
+    union fern_Data data;
+    fern_DataReader positions = { .format = fern_Format_natural_32_bit, .size = s.count, .natural_32_bit = s.positions };
+    fern_internal_select(positions, xar.cells, xar.cells.size / (s.stride ? s.stride : 1), s.stride, &data);
+    part = fern_mk_array(&s.shape, &data, fern_array_fill(xar));
+    fern_free_data(&data);
+  }
+  fern_Box value = evokation == fern_Evokation_dyad ? CALL_2(f, part, CALL_1(g, w)) : CALL_1(f, part);
+
+  // an atom stands for itself as the only cell of a unit 𝔾 𝕩
+  bool cells = !s.atom && fern_is_array(value);
+  if(!s.atom) {
+    fern_ArrayReader par = fern_read_array(fern_unpack_array(part));
+    fern_assert_fatal_error(
+        cells
+          ? fern_internal_match_shape(fern_unpack_array(value), fern_unpack_array(part)) && fern_read_array(fern_unpack_array(value)).cells.size == par.cells.size
+          : fern_array_rank(par) == 0
+      , "⌾: 𝔽 must keep the shape of 𝔾 𝕩"
+      );
+  }
+  fern_DataReader values = cells
+    ? fern_read_array(fern_unpack_array(value)).cells
+    : (fern_DataReader) { .format = fern_Format_box, .size = 1, .box = &value };
+
+  // 𝕩 is only written to when 𝔽 did not read it and the new cells fit its format
+  fern_Format format = fern_internal_unify_format(xar.cells.format, fern_internal_cell_format(values));
+  bool owned = x.bits == fern_internal_owned.bits && format == xar.cells.format
+            && (!xa->cells.is_pointer || (xa->cells.pointer.rc && *(uint32_t *)xa->cells.pointer.rc == 1));
+  fern_internal_owned = fern_nil();
+
+  fern_Box result = x;
+  void * dst = (void *)xar.cells.pointer;
+  if(!owned) {
+    union fern_Data data;
+    dst = fern_init_data(&data, format, xar.cells.size);
+    fern_internal_convert_cells(dst, format, 0, xar.cells);
+    result = fern_mk_array(&xa->shape, &data, fern_array_fill(xar));
+    fern_free_data(&data);
+    dst = (void *)fern_read_array(fern_unpack_array(result)).cells.pointer;
+  }
+  if(!fern_internal_scatter(dst, format, s.positions, s.count, s.stride, values)) {
+    fern_fatal_error("⌾: Incompatible result elements in structural Under");
+  }
+
+  free(s.positions);
+  fern_free_data(&s.shape);
+  fern_internal_fresh = result;
+  return result;
+}
+static struct fern_Modifier2 fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_JOT_mod2 = { .type = fern_Modifier2Type_c, .c = fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_JOT_evokation0 };
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_JOT(void) {
+  return fern_pack_modifier2(&fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_JOT_mod2);
+}
+
 // ⊘ valences -------------------------------------------------------------------------------------------------------------------------------------------------
 // 'any 𝔽⊘𝔾'     -> any - call '𝕩 𝔽'
 // 'any 𝔽⊘𝔾 any' -> any - call '𝕩 𝔾 𝕨'
@@ -1109,11 +3462,14 @@ static fern_Box fern_CIRCLED_TRIANGLE_DOWN_evokation0(fern_Evokation evokation,
   switch(evokation) {
   case fern_Evokation_monad:
   case fern_Evokation_dyad:
-    if(fern_ExStack_begin(&exstack)) {
+    fern_ExStack_begin(&exstack);
+    fern_VMState vm = fern_internal_vm_save();
+    if(setjmp(exstack.buf) == 0) {
       fern_Box result = fern_evoke(f, evokation, x, w);
       fern_ExStack_end(&exstack);
       return result;
     } else {
+      fern_internal_vm_restore(vm);
       return fern_evoke(g, evokation, x, w);
     }
   case fern_Evokation_write_to_backend:
@@ -1123,12 +3479,280 @@ static fern_Box fern_CIRCLED_TRIANGLE_DOWN_evokation0(fern_Evokation evokation,
   }
   return fern_DIGIT_ZERO();
 }
+
+// only ! reaches fern_internal_throw. derived functions throw through their operands, blocks are assumed to. 𝔽 of a ⎊ is
+// caught there, so only its 𝔾 counts
+static bool may_throw(fern_Box f) {
+  if(!fern_is_function(f)) {
+    return false;
+  }
+  fern_Function function = fern_unpack_function(f);
+  switch(function->type) {
+  case fern_FunctionType_c:
+    return function->c == fern_EXCLAMATION_MARK_evokation0;
+  case fern_FunctionType_applied_c_m1:
+    return may_throw(function->applied_c_m1.f);
+  case fern_FunctionType_applied_c_m2:
+    return (function->applied_c_m2.m != fern_CIRCLED_TRIANGLE_DOWN_evokation0 && may_throw(function->applied_c_m2.f))
+        || may_throw(function->applied_c_m2.g);
+  case fern_FunctionType_train2:
+    return may_throw(function->train2.g) || may_throw(function->train2.h);
+  case fern_FunctionType_train3:
+    return may_throw(function->train3.f) || may_throw(function->train3.g) || may_throw(function->train3.h);
+  default:
+    return true;
+  }
+}
+
+// whether 𝔽 is ! or has a closure where ! is the only step that may throw, so a failing ! can be seen in place
+static bool catch_checkable(fern_Box f) {
+  fern_Function function = fern_unpack_function(f);
+  if(function->type == fern_FunctionType_c) {
+    return true;
+  }
+  if(function->closure == NULL) {
+    return false;
+  }
+  for(fern_Evokation e = fern_Evokation_monad; e <= fern_Evokation_dyad; e++) {
+    for(uint32_t i = 0; i < function->closure->code[e].num_steps; i++) {
+      const fern_ClosureStep * step = function->closure->code[e].steps + i;
+      if(step->c == NULL && may_throw(step->callee)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// 𝔽 with each ! checked in place, as fern_evoke_closure does the steps otherwise. false where ! would have thrown
+static bool catch_evoke_checked(fern_Box f, fern_Evokation evokation, fern_Box x, fern_Box w, fern_Box * result) {
+  fern_Function function = fern_unpack_function(f);
+  if(function->type == fern_FunctionType_c) {
+    *result = x;
+    return fern_is_number(x) && x.number == 1;
+  }
+  fern_Closure closure = function->closure;
+  fern_Box registers[2 + 2 * fern_CLOSURE_MAX];
+  uint32_t num_steps = closure->code[evokation].num_steps;
+  registers[0] = x;
+  registers[1] = w;
+  memcpy(registers + 2 + num_steps, closure->consts, sizeof(fern_Box) * closure->num_consts);
+  for(uint32_t i = 0; i < num_steps; i++) {
+    const fern_ClosureStep * step = closure->code[evokation].steps + i;
+    fern_Box sx = registers[step->x];
+    if(step->c == fern_EXCLAMATION_MARK_evokation0) {
+      if(!fern_is_number(sx) || sx.number != 1) {
+        return false;
+      }
+      registers[2 + i] = sx;
+    } else if(step->w == fern_CLOSURE_NONE) {
+      registers[2 + i] = step->monad ? step->monad(sx) : CALL_1(step->callee, sx);
+    } else {
+      registers[2 + i] = step->dyad ? step->dyad(sx, registers[step->w]) : CALL_2(step->callee, sx, registers[step->w]);
+    }
+  }
+  *result = registers[closure->code[evokation].result];
+  return true;
+}
+
+static fern_Box catch_unguarded_monad(fern_Box f, fern_Box g, fern_Box x) {
+  return CALL_1(f, x);
+}
+static fern_Box catch_unguarded_dyad(fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
+  return CALL_2(f, x, w);
+}
+static fern_Box catch_checked_monad(fern_Box f, fern_Box g, fern_Box x) {
+  fern_Box result;
+  return catch_evoke_checked(f, fern_Evokation_monad, x, fern_nil(), &result) ? result : CALL_1(g, x);
+}
+static fern_Box catch_checked_dyad(fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
+  fern_Box result;
+  return catch_evoke_checked(f, fern_Evokation_dyad, x, w, &result) ? result : CALL_2(g, x, w);
+}
+
+// the entry points of 𝔽⎊𝔾 by what 𝔽 can throw. the handler of the evokation, a setjmp on every call, is only left for 𝔽
+// that throws from somewhere it cannot be checked in place. false for anything else
+static bool catch_recognize(fern_Function function) {
+  if(function->type != fern_FunctionType_applied_c_m2 || function->applied_c_m2.m != fern_CIRCLED_TRIANGLE_DOWN_evokation0) {
+    return false;
+  }
+  fern_Box f = function->applied_c_m2.f;
+  if(!may_throw(f)) {
+    function->applied_c_m2.monad = catch_unguarded_monad;
+    function->applied_c_m2.dyad = catch_unguarded_dyad;
+    return true;
+  }
+  if(catch_checkable(f)) {
+    function->applied_c_m2.monad = catch_checked_monad;
+    function->applied_c_m2.dyad = catch_checked_dyad;
+    return true;
+  }
+  return false;
+}
 static struct fern_Modifier2 fern_CIRCLED_TRIANGLE_DOWN_mod2 = { .type = fern_Modifier2Type_c, .c = fern_CIRCLED_TRIANGLE_DOWN_evokation0 };
 fern_Box fern_CIRCLED_TRIANGLE_DOWN(void) {
   return fern_pack_modifier2(&fern_CIRCLED_TRIANGLE_DOWN_mod2);
 }
 
 // ⎉ rank -----------------------------------------------------------------------------------------------------------------------------------------------------
+// 'any 𝔽⎉𝔾'     -> array - 𝔽 on the cells of 𝕩 of rank 𝔾, negative ranks counting frame axes
+// 'any 𝔽⎉𝔾 any' -> array - 𝔽 on matching cells of 𝕨 and 𝕩, 𝔾 being one rank, ⟨left, right⟩ or ⟨monad, left, right⟩
+static fern_Box fern_CIRCLED_HORIZONTAL_BAR_WITH_NOTCH_evokation0(fern_Evokation evokation, fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
+  if(evokation == fern_Evokation_write_to_backend || evokation == fern_Evokation_inverse) {
+    fern_fatal_error("not implemented");
+  }
+  fern_Box ranks = fern_is_function(g) ? fern_evoke(g, evokation, x, w) : g;
+
+  int64_t r[3];
+  if(fern_is_number(ranks)) {
+    r[0] = r[1] = r[2] = ranks.number;
+  } else {
+    fern_assert_fatal_error(fern_is_array(ranks), "⎉: 𝔾 must give one to three integers");
+    fern_DataReader cells = fern_read_array(fern_unpack_array(ranks)).cells;
+    fern_assert_fatal_error(cells.size >= 1 && cells.size <= 3, "⎉: 𝔾 must give one to three integers");
+    for(uint32_t i = 0; i < 3; i++) {
+      // ⟨m⟩ is every rank, ⟨l, r⟩ uses r for the monad, ⟨m, l, r⟩ is each
+      uint32_t index = cells.size == 1 ? 0 : cells.size == 2 ? (i == 0 ? 1 : i - 1) : i;
+      fern_Box k = fern_data_get_cell(cells, index);
+      fern_assert_fatal_error(fern_is_number(k) && round(k.number) == k.number, "⎉: 𝔾 must give one to three integers");
+      r[i] = k.number;
+    }
+  }
+
+  return evoke_cells(f, evokation, x, w, r[0], r[1], r[2], "⎉: Leading axes of 𝕨 and 𝕩 must agree and results must have the same shape");
+}
+static struct fern_Modifier2 fern_CIRCLED_HORIZONTAL_BAR_WITH_NOTCH_mod2 = { .type = fern_Modifier2Type_c, .c = fern_CIRCLED_HORIZONTAL_BAR_WITH_NOTCH_evokation0 };
+fern_Box fern_CIRCLED_HORIZONTAL_BAR_WITH_NOTCH(void) {
+  return fern_pack_modifier2(&fern_CIRCLED_HORIZONTAL_BAR_WITH_NOTCH_mod2);
+}
+
 // ⚇ depth ----------------------------------------------------------------------------------------------------------------------------------------------------
 // ⍟ repeat ---------------------------------------------------------------------------------------------------------------------------------------------------
 
+static bool match_cells(fern_DataReader a, fern_DataReader b) {
+  if(a.size != b.size) {
+    return false;
+  }
+  for(uint32_t i = 0; i < a.size; i++) {
+    if(!fern_internal_match(fern_data_get_cell(a, i), fern_data_get_cell(b, i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// the cells of 𝕩 after `count` steps of a scalar 𝔽. primitives step in one buffer, compositions go through lift_scalar and
+// free each intermediate as soon as the next one exists
+static bool repeat_cells(fern_Box f, bool monad, fern_DataReader x, fern_DataReader w, uint64_t count, fern_Data result) {
+  fern_ScalarOp op = fern_internal_scalar_op(f);
+  if(op != fern_ScalarOp_none) {
+    return fern_internal_scalar_repeat(op, monad, x, w, count, result);
+  }
+  if(!lift_cells(f, monad, x, monad ? x : w, x.size, result)) {
+    return false;
+  }
+  for(uint64_t k = 1; k < count; k++) {
+    union fern_Data next;
+    fern_DataReader current = fern_read_data(result);
+    if(!lift_cells(f, monad, current, monad ? current : w, x.size, &next)) {
+      fern_free_data(result);
+      return false;
+    }
+    bool fixed = match_cells(fern_read_data(&next), current);
+    fern_free_data(result);
+    *result = next;
+    if(fixed) {
+      break;
+    }
+  }
+  return true;
+}
+
+// 𝕩 after `count` steps, stopping as soon as a step gives back its argument since every later step would too
+static fern_Box repeat_steps(fern_Box f, bool monad, fern_Box x, fern_Box w, uint64_t count) {
+  if(count == 0) {
+    return x;
+  }
+
+  // scalar 𝔽 runs on the cells of 𝕩, which keep their shape while 𝕨 is an atom or has that shape too
+  bool same_shape = monad || !fern_is_array(w) || (fern_is_array(x) && fern_internal_match_shape(fern_unpack_array(x), fern_unpack_array(w)));
+  fern_DataReader x_cells = frame_cells(&x);
+  if(same_shape && x_cells.size != 0 && frame_complete(x) && frame_complete(w)) {
+    union fern_Data data;
+    if(repeat_cells(f, monad, x_cells, frame_cells(&w), count, &data)) {
+      if(!fern_is_array(x)) {
+        fern_Box result = fern_data_get_cell(fern_read_data(&data), 0);
+        fern_free_data(&data);
+        return result;
+      }
+      fern_Array xa = fern_unpack_array(x);
+      return fern_mk_array(&xa->shape, &data, fern_array_fill(fern_read_array(xa)));
+    }
+  }
+
+  for(uint64_t k = 0; k < count; k++) {
+    fern_Box next = monad ? CALL_1(f, x) : CALL_2(f, x, w);
+    if(fern_internal_match(next, x)) {
+      break;
+    }
+    x = next;
+  }
+  return x;
+}
+
+static uint64_t repeat_count(fern_Box n) {
+  fern_assert_fatal_error(fern_is_number(n) && round(n.number) == n.number, "⍟: 𝔾 must give integers");
+  if(n.number < 0) {
+    fern_fatal_error("⍟: negative counts need 𝔽⁼, not implemented");
+  }
+  fern_assert_fatal_error(n.number < 18446744073709551616.0, "⍟: count too large");
+  return n.number;
+}
+
+// 'any 𝔽⍟𝔾'     -> any - 𝔽 applied n times to 𝕩, n being 𝔾 or '𝕩 𝔾'. an array of counts gives the result for each count
+// 'any 𝔽⍟𝔾 any' -> any - '𝕨 𝔽 𝕩' applied n times to 𝕩 with the same 𝕨, n being 𝔾 or '𝕩 𝔾 𝕨'
+static fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STAR_evokation0(fern_Evokation evokation, fern_Box f, fern_Box g, fern_Box x, fern_Box w) {
+  if(evokation == fern_Evokation_write_to_backend || evokation == fern_Evokation_inverse) {
+    fern_fatal_error("not implemented");
+  }
+  bool monad = evokation == fern_Evokation_monad;
+  fern_Box n = fern_is_function(g) ? fern_evoke(g, evokation, x, w) : g;
+  if(monad) {
+    w = x;
+  }
+
+  if(!fern_is_array(n)) {
+    return repeat_steps(f, monad, x, w, repeat_count(n));
+  }
+
+  // an array of counts is walked in increasing order, each count continuing from the result of the one before
+  fern_Array na = fern_unpack_array(n);
+  fern_ArrayReader nar = fern_read_array(na);
+  uint32_t size = fern_array_num_cells(nar);
+  union fern_Data keys;
+  union fern_Data data;
+  fern_Box * counts = fern_init_data(&keys, fern_Format_box, size);
+  for(uint32_t i = 0; i < size; i++) {
+    counts[i] = fern_pack_number(repeat_count(fern_array_get_cell(nar, i)));
+  }
+  uint32_t * order = malloc(sizeof(uint32_t) * (size + 1));
+  fern_internal_grade(fern_read_data(&keys), false, order);
+
+  fern_Box * cells = fern_init_data(&data, fern_Format_box, size);
+  fern_Box value = x;
+  uint64_t done = 0;
+  for(uint32_t k = 0; k < size; k++) {
+    uint64_t count = counts[order[k]].number;
+    value = repeat_steps(f, monad, value, w, count - done);
+    done = count;
+    cells[order[k]] = value;
+  }
+  free(order);
+  fern_free_data(&keys);
+
+  return fern_mk_array(&na->shape, &data, fern_DIGIT_ZERO());
+}
+static struct fern_Modifier2 fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STAR_mod2 = { .type = fern_Modifier2Type_c, .c = fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STAR_evokation0 };
+fern_Box fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STAR(void) {
+  return fern_pack_modifier2(&fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STAR_mod2);
+}
@@ -64,19 +64,30 @@ void memory_free(void * unaligned) {
   free(pointer);
 }
 
+uint32_t fern_internal_format_bit_size(fern_Format format) {
+  return _format_bit_size[format];
+}
+
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// keeps the cells after the reference count aligned for any format
+#define _DATA_HEADER_SIZE 16
+
 void * fern_init_data(fern_Data data, fern_Format format, uint32_t size) {
   void * result = data->inplace.data;
   
-  uint32_t bit_size  = _format_bit_size[format] * size;
-  uint32_t byte_size = (bit_size + 7) >> 3;
+  uint64_t bit_size  = (uint64_t)_format_bit_size[format] * size;
+  uint64_t byte_size = (bit_size + 7) >> 3;
   
-  if(byte_size < sizeof(uintptr_t) - 2) {
+  if(byte_size > sizeof(data->inplace.data)) {
+    // the reference count heads the same allocation as the cells, so slices can point anywhere into the cells and the
+    // whole block is still freed through rc
+    uint8_t * block = malloc(_DATA_HEADER_SIZE + byte_size);
+    *(uint32_t *)block = 1;
     data->is_pointer = 1;
     data->pointer.format = format;
     data->pointer.size = size;
-    data->pointer.rc = (uintptr_t)malloc(sizeof(uint32_t));
-    data->pointer.pointer = (uintptr_t)malloc(byte_size);
+    data->pointer.rc = (uintptr_t)block;
+    data->pointer.pointer = (uintptr_t)(block + _DATA_HEADER_SIZE);
     result = (void *)data->pointer.pointer;
   } else {
     data->is_pointer = 0;
@@ -95,13 +106,26 @@ void fern_clone_data(fern_Data data, fern_Data other) {
   }
 }
 
+// cells [start, start + size) of other. pointer data is shared when the slice starts on a byte, everything else is copied
+void fern_slice_data(fern_Data data, fern_Data other, uint32_t start, uint32_t size) {
+  fern_DataReader reader = fern_read_data(other);
+  uint64_t bit_start = (uint64_t)_format_bit_size[reader.format] * start;
+  if(other->is_pointer && (bit_start & 7) == 0) {
+    fern_clone_data(data, other);
+    data->pointer.size = size;
+    data->pointer.pointer += bit_start >> 3;
+    return;
+  }
+  void * cells = fern_init_data(data, reader.format, size);
+  fern_internal_copy_cells(cells, 0, reader, start, size);
+}
+
 void fern_free_data(fern_Data data) {
   if(data->is_pointer && data->pointer.rc) {
     uint32_t * rc = (uint32_t *)data->pointer.rc;
     fern_assert_fatal_error(*rc != 0, "reference counted data has invalid state");
     if(0 == --(*rc)) {
       free(rc);
-      free((void *)data->pointer.pointer);
     }
   }
 }
@@ -114,16 +138,19 @@ fern_Array fern_allocate_array(void) {
 
 fern_Function fern_allocate_function(void) {
   fern_Function function = malloc(sizeof(*function));
+  *function = (struct fern_Function){ .closure = NULL };
   return function;
 }
 
 fern_Modifier1 fern_allocate_modifier1(void) {
   fern_Modifier1 modifier1 = malloc(sizeof(*modifier1));
+  *modifier1 = (struct fern_Modifier1){ .c = NULL };
   return modifier1;
 }
 
 fern_Modifier2 fern_allocate_modifier2(void) {
   fern_Modifier2 modifier2 = malloc(sizeof(*modifier2));
+  *modifier2 = (struct fern_Modifier2){ .c = NULL };
   return modifier2;
 }
 
@@ -140,12 +167,11 @@ fern_Stream fern_allocate_stream(void) {
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 void fern_init_shape(fern_Data data, uint32_t rank, uint32_t * shape) {
-  fern_Format shape_format = fern_Format_natural_8_bit;
+  uint32_t max = 0;
   for(uint32_t i = 0; i < rank; i++) {
-    while(shape[i] > (shape_format << 3)) {
-      shape_format++; 
-    }
+    max = shape[i] > max ? shape[i] : max;
   }
+  fern_Format shape_format = fern_internal_natural_format(max);
   void * shape_w = fern_init_data(data, shape_format, rank);
   if(shape_format == fern_Format_natural_8_bit) {
     for(uint32_t i = 0; i < rank; i++) {
@@ -169,7 +195,7 @@ void fern_init_array(fern_Array array, fern_Data shape, fern_Data cells, fern_Bo
 }
 
 void fern_init_array2(fern_Array array, uint32_t rank, uint32_t * shape, fern_Data cells, fern_Box fill) {
-  fern_init_shape(&array->shape, 1, shape);
+  fern_init_shape(&array->shape, rank, shape);
   fern_clone_data(&array->cells, cells);
   array->fill = fill;
 }
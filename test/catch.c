@@ -0,0 +1,51 @@
+// ! in 𝔽 of ⎊ is caught whichever entry point ⎊ was given for 𝔽: none for 𝔽 that cannot throw, ! checked in place, or
+// the handler of the evokation
+#include <stdio.h>
+
+#include "local.h"
+#include "test.h"
+
+static bool has_entry(fern_Box f) {
+  return fern_unpack_function(f)->applied_c_m2.monad != NULL;
+}
+
+int main(void) {
+  fern_Box one = fern_DIGIT_ONE();
+  fern_Box five = fern_pack_number(5);
+  fern_Box catch = fern_CIRCLED_TRIANGLE_DOWN();
+  fern_Box bang = fern_EXCLAMATION_MARK();
+
+  // no ! in 𝔽, called without a handler
+  fern_Box plain = m2(fern_PLUS_SIGN(), catch, fern_DIGIT_ZERO());
+  CHECK("+⎊0 has an entry point", has_entry(plain));
+  CHECK("+⎊0 5", is(CALL_1(plain, five), 5));
+
+  // ! itself and a train of ! are checked in place
+  fern_Box checked = m2(bang, catch, fern_pack_number(-1));
+  CHECK("!⎊¯1 has an entry point", has_entry(checked));
+  CHECK("!⎊¯1 1", is(CALL_1(checked, one), 1));
+  CHECK("!⎊¯1 5", is(CALL_1(checked, five), -1));
+  CHECK("\"m\" !⎊¯1 5", is(CALL_2(checked, five, fern_mk_symbol("m")), -1));
+  fern_Box train = m2(train3(fern_RIGHT_TACK(), bang, fern_RIGHT_TACK()), catch, fern_pack_number(-2));
+  CHECK("(⊢!⊢)⎊¯2 has an entry point", has_entry(train));
+  CHECK("(⊢!⊢)⎊¯2 1", is(CALL_1(train, one), 1));
+  CHECK("(⊢!⊢)⎊¯2 5", is(CALL_1(train, five), -2));
+
+  // ! under ¨ is not seen as a step, so it is not unguarded and goes through the handler
+  fern_Box each = m2(m1(bang, fern_DIAERESIS()), catch, fern_pack_number(-3));
+  CHECK("!¨⎊¯3 has no entry point", !has_entry(each));
+  CHECK("!¨⎊¯3 ⟨1, 0⟩", is(CALL_1(each, list(2, (double[]){ 1, 0 })), -3));
+  CHECK("!¨⎊¯3 ⟨1, 1⟩", fern_is_array(CALL_1(each, list(2, (double[]){ 1, 1 }))));
+
+  // ! in 𝔽 of an inner ⎊ cannot escape it, so the outer one is unguarded and the inner one still catches
+  fern_Box unguarded = m2(m2(bang, catch, fern_pack_number(-4)), catch, fern_pack_number(-5));
+  CHECK("(!⎊¯4)⎊¯5 has an entry point", has_entry(unguarded));
+  CHECK("(!⎊¯4)⎊¯5 5", is(CALL_1(unguarded, five), -4));
+
+  // ! in 𝔾 of an inner ⎊ escapes it, to the outer one
+  fern_Box rethrow = m2(m2(bang, catch, bang), catch, fern_pack_number(-6));
+  CHECK("(!⎊!)⎊¯6 has no entry point", !has_entry(rethrow));
+  CHECK("(!⎊!)⎊¯6 5", is(CALL_1(rethrow, five), -6));
+
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
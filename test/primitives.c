@@ -0,0 +1,189 @@
+// the array primitives on small arguments: each kernel on lists and tables, on empty arrays, on arrays stored in the
+// narrow natural formats next to boxed ones, and on arrays whose last cells are the fill rather than stored
+#include <stdio.h>
+
+#include "local.h"
+#include "test.h"
+
+#define L(...) list(sizeof((double[]){ __VA_ARGS__ }) / sizeof(double), (double[]){ __VA_ARGS__ })
+#define IS(X, ...) is_list(X, sizeof((double[]){ __VA_ARGS__ }) / sizeof(double), (double[]){ __VA_ARGS__ })
+
+// a list stored in the format, which has to hold the values
+static fern_Box naturals(fern_Format format, uint32_t n, const double * values) {
+  fern_Box boxes = list(n, values);
+  union fern_Data data;
+  void * cells = fern_init_data(&data, format, n);
+  fern_internal_convert_range(cells, format, 0, fern_read_array(fern_unpack_array(boxes)).cells, 0, n);
+  return fern_mk_array2(1, &n, &data, fern_DIGIT_ZERO());
+}
+
+#define N8(...) naturals(fern_Format_natural_8_bit, sizeof((double[]){ __VA_ARGS__ }) / sizeof(double), (double[]){ __VA_ARGS__ })
+#define N32(...) naturals(fern_Format_natural_32_bit, sizeof((double[]){ __VA_ARGS__ }) / sizeof(double), (double[]){ __VA_ARGS__ })
+
+static fern_Box empty(void) {
+  return CALL_1(fern_UP_DOWN_ARROW(), fern_DIGIT_ZERO());
+}
+
+// 𝕨⥊↕×´𝕨 for a list 𝕨 of two
+static fern_Box table(uint32_t rows, uint32_t columns) {
+  fern_Box shape = L(rows, columns);
+  fern_Box cells = CALL_1(fern_UP_DOWN_ARROW(), fern_pack_number(rows * columns));
+  return CALL_2(fern_LEFT_BARB_UP_RIGHT_BARB_DOWN_HARPOON(), cells, shape);
+}
+
+static bool is_table(fern_Box x, uint32_t rows, uint32_t columns, const double * values) {
+  return is_array(x, 2, (uint32_t[]){ rows, columns }, values);
+}
+
+// an array of the shape whose first n cells are these numbers
+static bool starts(fern_Box x, uint32_t rank, const uint32_t * shape, uint32_t n, const double * values) {
+  if(!fern_is_array(x)) {
+    return false;
+  }
+  fern_ArrayReader a = fern_read_array(fern_unpack_array(x));
+  bool result = fern_array_rank(a) == rank && fern_array_num_cells(a) >= n;
+  for(uint32_t i = 0; result && i < rank; i++) {
+    result = fern_array_axis_length(a, i) == shape[i];
+  }
+  for(uint32_t i = 0; result && i < n; i++) {
+    result = is(fern_array_get_cell(a, i), values[i]);
+  }
+  return result;
+}
+
+static bool is_format(fern_Box x, fern_Format format) {
+  return fern_is_array(x) && fern_read_array(fern_unpack_array(x)).cells.format == format;
+}
+
+static bool is_empty(fern_Box x) {
+  return is_list(x, 0, NULL);
+}
+
+int main(void) {
+  fern_Box scan = fern_GRAVE_ACCENT();
+  fern_Box fold = fern_ACUTE_ACCENT();
+  fern_Box plus = fern_PLUS_SIGN();
+  fern_Box range = fern_UP_DOWN_ARROW();
+  fern_Box five = fern_pack_number(5);
+  fern_Box reshape = fern_LEFT_BARB_UP_RIGHT_BARB_DOWN_HARPOON();
+  fern_Box reverse = fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STILE();
+  fern_Box find = fern_APL_FUNCTIONAL_SYMBOL_EPSILON_UNDERBAR();
+  fern_Box repeat = fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_STAR();
+  fern_Box take = fern_UPWARDS_ARROW();
+
+  // ` scan
+  CHECK("+`↕5", IS(CALL_1(m1(plus, scan), CALL_1(range, five)), 0, 1, 3, 6, 10));
+  CHECK("⌊` 8-bit", IS(CALL_1(m1(fern_LEFT_FLOOR(), scan), N8(3, 1, 2)), 3, 1, 1));
+  CHECK("≠` booleans", IS(CALL_1(m1(fern_NOT_EQUAL_SIGN(), scan), L(1, 0, 1, 1)), 1, 1, 0, 1));
+  CHECK("+`⟨⟩", is_empty(CALL_1(m1(plus, scan), empty())));
+  CHECK("+` 3‿2", is_table(CALL_1(m1(plus, scan), table(3, 2)), 3, 2, (double[]){ 0, 1, 2, 4, 6, 9 }));
+  CHECK("+` over fills", IS(CALL_1(m1(plus, scan), CALL_2(fern_UPWARDS_ARROW(), L(1, 2), five)), 1, 3, 3, 3, 3));
+
+  // ∧ ∨ ⍋ ⍒
+  CHECK("∧ 8-bit", IS(CALL_1(fern_LOGICAL_AND(), N8(3, 1, 2)), 1, 2, 3));
+  CHECK("∨ boxed", IS(CALL_1(fern_LOGICAL_OR(), L(3, 1, 2)), 3, 2, 1));
+  CHECK("⍋", IS(CALL_1(fern_APL_FUNCTIONAL_SYMBOL_DELTA_STILE(), N32(30, 10, 20)), 1, 2, 0));
+  CHECK("⍒", IS(CALL_1(fern_APL_FUNCTIONAL_SYMBOL_DEL_STILE(), L(3, 1, 2)), 0, 2, 1));
+  CHECK("⍋⟨⟩", is_empty(CALL_1(fern_APL_FUNCTIONAL_SYMBOL_DELTA_STILE(), empty())));
+
+  // ⊐ ⊒ ∊
+  CHECK("8-bit ⊐ 32-bit", IS(CALL_2(fern_SQUARE_ORIGINAL_OF(), N32(7, 5, 9), N8(5, 6, 7)), 2, 0, 3));
+  CHECK("⊒", IS(CALL_2(fern_SQUARE_ORIGINAL_OF_OR_EQUAL_TO(), L(1, 1, 1), L(1, 1, 2)), 0, 1, 3));
+  CHECK("boxed ∊ 8-bit", IS(CALL_2(fern_SMALL_ELEMENT_OF(), N8(2, 3), L(1, 2, 300)), 0, 1, 0));
+  CHECK("⟨⟩ ⊐", IS(CALL_2(fern_SQUARE_ORIGINAL_OF(), L(4, 5), empty()), 0, 0));
+
+  // ⊔
+  fern_Box groups = CALL_1(fern_SQUARE_CUP(), L(0, 1, 0, 2));
+  CHECK("⊔", fern_is_array(groups) && fern_array_num_cells(fern_read_array(fern_unpack_array(groups))) == 3
+          && IS(fern_array_get_cell(fern_read_array(fern_unpack_array(groups)), 0), 0, 2));
+
+  // / replicate and indices
+  CHECK("/ 1‿0‿2", IS(CALL_1(fern_SOLIDUS(), L(1, 0, 2)), 0, 2, 2));
+  CHECK("1‿0‿2 / 8-bit", IS(CALL_2(fern_SOLIDUS(), N8(5, 6, 7), L(1, 0, 2)), 5, 7, 7));
+  CHECK("/⟨⟩", is_empty(CALL_1(fern_SOLIDUS(), empty())));
+
+  // ⌽ ⍉
+  CHECK("⌽", IS(CALL_1(reverse, N8(1, 2, 3)), 3, 2, 1));
+  CHECK("1⌽↕4", IS(CALL_2(reverse, CALL_1(range, fern_pack_number(4)), fern_DIGIT_ONE()), 1, 2, 3, 0));
+  CHECK("⍉ 2‿3", is_table(CALL_1(fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_BACKSLASH(), table(2, 3)), 3, 2, (double[]){ 0, 3, 1, 4, 2, 5 }));
+  CHECK("⌽⟨⟩", is_empty(CALL_1(reverse, empty())));
+  fern_Box cube = CALL_2(reshape, CALL_1(range, fern_pack_number(24)), L(2, 3, 4));
+  fern_Box transpose = fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_BACKSLASH();
+  fern_Box moved = CALL_2(transpose, cube, fern_DIGIT_ONE());
+  CHECK("1⍉2‿3‿4⥊↕24", starts(moved, 3, (uint32_t[]){ 3, 2, 4 }, 9, (double[]){ 0, 1, 2, 3, 12, 13, 14, 15, 4 }));
+  CHECK("2‿0⍉2‿3‿4⥊↕24", starts(CALL_2(transpose, cube, L(2, 0)), 3, (uint32_t[]){ 3, 4, 2 }, 4, (double[]){ 0, 12, 1, 13 }));
+  CHECK("0‿0⍉2‿3‿4⥊↕24", starts(CALL_2(transpose, cube, L(0, 0)), 2, (uint32_t[]){ 2, 4 }, 5, (double[]){ 0, 1, 2, 3, 16 }));
+
+  // ⊏
+  CHECK("2‿0 ⊏", IS(CALL_2(fern_SQUARE_IMAGE_OF(), N8(5, 6, 7), L(2, 0)), 7, 5));
+  CHECK("⟨⟩ ⊏", is_empty(CALL_2(fern_SQUARE_IMAGE_OF(), N8(5, 6, 7), empty())));
+
+  // ∾ ≍ ´
+  CHECK("8-bit ∾ boxed", IS(CALL_2(fern_INVERTED_LAZY_S(), L(3, 300), N8(1, 2)), 1, 2, 3, 300));
+  CHECK("⟨⟩ ∾ ⟨⟩", is_empty(CALL_2(fern_INVERTED_LAZY_S(), empty(), empty())));
+  CHECK("1‿2 ≍ 3‿4", is_table(CALL_2(fern_EQUIVALENT_TO(), L(3, 4), N8(1, 2)), 2, 2, (double[]){ 1, 2, 3, 4 }));
+  CHECK("+´", is(CALL_1(m1(plus, fold), N8(1, 2, 3)), 6));
+  CHECK("+´⟨⟩", is(CALL_1(m1(plus, fold), empty()), 0));
+  CHECK("×´⟨⟩", is(CALL_1(m1(fern_MULTIPLICATION_SIGN(), fold), empty()), 1));
+  CHECK("⌊´⟨⟩", is(CALL_1(m1(fern_LEFT_FLOOR(), fold), empty()), INFINITY));
+  CHECK("∧´⟨⟩", is(CALL_1(m1(fern_LOGICAL_AND(), fold), empty()), 1));
+  CHECK("+´˘ 3‿0", IS(CALL_1(m1(m1(plus, fold), fern_BREVE()), table(3, 0)), 0, 0, 0));
+  CHECK("×´˘ 2‿0", IS(CALL_1(m1(m1(fern_MULTIPLICATION_SIGN(), fold), fern_BREVE()), table(2, 0)), 1, 1));
+  CHECK("⌊´ 32-bit", is(CALL_1(m1(fern_LEFT_FLOOR(), fold), N32(70000, 2, 9)), 2));
+
+  // ⥊
+  CHECK("5⥊1‿2", IS(CALL_2(reshape, L(1, 2), five), 1, 2, 1, 2, 1));
+  CHECK("2‿3⥊↕4", is_table(CALL_2(reshape, CALL_1(range, fern_pack_number(4)), L(2, 3)), 2, 3, (double[]){ 0, 1, 2, 3, 0, 1 }));
+  CHECK("0⥊", is_empty(CALL_2(reshape, L(1, 2), fern_DIGIT_ZERO())));
+
+  // ¨ ⌜
+  CHECK("1‿2 +⌜ 10‿20", is_table(CALL_2(m1(plus, fern_TOP_LEFT_CORNER()), N8(10, 20), L(1, 2)), 2, 2, (double[]){ 11, 21, 12, 22 }));
+  CHECK("8-bit +¨ boxed", IS(CALL_2(m1(plus, fern_DIAERESIS()), L(1, 2), N8(10, 20)), 11, 22));
+  CHECK("-¨⟨⟩", is_empty(CALL_1(m1(fern_HYPHEN_MINUS(), fern_DIAERESIS()), empty())));
+
+  // ˘ ⎉
+  CHECK("+´˘ 2‿3", IS(CALL_1(m1(m1(plus, fold), fern_BREVE()), table(2, 3)), 3, 12));
+  fern_Box couple_cells = m1(fern_EQUIVALENT_TO(), fern_BREVE());
+  CHECK("1‿2 ≍˘ 3‿4", is_table(CALL_2(couple_cells, L(3, 4), N8(1, 2)), 2, 2, (double[]){ 1, 3, 2, 4 }));
+  fern_Box couple_atoms = m2(fern_EQUIVALENT_TO(), fern_CIRCLED_HORIZONTAL_BAR_WITH_NOTCH(), fern_DIGIT_ZERO());
+  CHECK("1‿2 ≍⎉0 3‿4", is_table(CALL_2(couple_atoms, L(3, 4), L(1, 2)), 2, 2, (double[]){ 1, 3, 2, 4 }));
+  CHECK("1 ≍⎉0 3‿4", is_table(CALL_2(couple_atoms, L(3, 4), fern_DIGIT_ONE()), 2, 2, (double[]){ 1, 3, 1, 4 }));
+  CHECK("1‿2 +˘ 3‿4", IS(CALL_2(m1(plus, fern_BREVE()), N8(3, 4), L(1, 2)), 4, 6));
+  fern_Box rows = m2(reverse, fern_CIRCLED_HORIZONTAL_BAR_WITH_NOTCH(), fern_DIGIT_ONE());
+  CHECK("⌽⎉1 2‿3", is_table(CALL_1(rows, table(2, 3)), 2, 3, (double[]){ 2, 1, 0, 5, 4, 3 }));
+
+  // ⍟
+  fern_Box increment = m2(fern_DIGIT_ONE(), fern_MULTIMAP(), plus);
+  CHECK("1⊸+⍟3 0", is(CALL_1(m2(increment, repeat, fern_pack_number(3)), fern_DIGIT_ZERO()), 3));
+  CHECK("1⊸+⍟0 0", is(CALL_1(m2(increment, repeat, fern_DIGIT_ZERO()), fern_DIGIT_ZERO()), 0));
+
+  // ⌾
+  fern_Box under = fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_JOT();
+  fern_Box second = m2(fern_DIGIT_ONE(), fern_MULTIMAP(), fern_SQUARE_IMAGE_OF_OR_EQUAL_TO());
+  CHECK("-⌾(1⊸⊑)", IS(CALL_1(m2(fern_HYPHEN_MINUS(), under, second), N8(10, 20, 30)), 10, -20, 30));
+  fern_Box last = m2(fern_pack_number(-1), fern_MULTIMAP(), fern_SQUARE_IMAGE_OF_OR_EQUAL_TO());
+  CHECK("¯1⊑", is(CALL_2(fern_SQUARE_IMAGE_OF_OR_EQUAL_TO(), N8(10, 20, 30), fern_pack_number(-1)), 30));
+  CHECK("-⌾(¯1⊸⊑)", IS(CALL_1(m2(fern_HYPHEN_MINUS(), under, last), N8(10, 20, 30)), 10, 20, -30));
+  CHECK("1‿2‿3 +⌾(¯1⊸⊑)", IS(CALL_2(m2(plus, under, last), N8(10, 20, 30), L(1, 2, 3)), 10, 20, 33));
+  fern_Box odd = m2(L(1, 0, 1), fern_MULTIMAP(), fern_SOLIDUS());
+  CHECK("⌽⌾(1‿0‿1⊸/)", IS(CALL_1(m2(reverse, under, odd), L(1, 2, 3)), 3, 2, 1));
+
+  // ⍷
+  CHECK("1‿2 ⍷ 8-bit", IS(CALL_2(find, N8(1, 2, 1, 2), L(1, 2)), 1, 0, 1));
+  fern_Box prefix = CALL_2(take, N32(1, 2, 70000), fern_pack_number(2));
+  CHECK("(2↑ 32-bit) ⍷ 8-bit", IS(CALL_2(find, N8(1, 2, 3), prefix), 1, 0));
+  CHECK("32-bit ⍷ 8-bit", IS(CALL_2(find, N8(1, 2, 3), N32(2, 3)), 0, 1));
+  CHECK("32-bit 70000 ⍷ 8-bit", IS(CALL_2(find, N8(1, 2, 3), N32(70000)), 0, 0, 0));
+  CHECK("⟨⟩ ⍷", IS(CALL_2(find, L(1, 2), empty()), 1, 1, 1));
+
+  // ↑ ↓ « »
+  CHECK("2↑", IS(CALL_2(take, N8(1, 2, 3), fern_pack_number(2)), 1, 2));
+  CHECK("5↑ fills", IS(CALL_2(take, N8(1, 2), five), 1, 2, 0, 0, 0));
+  CHECK("¯2↑", IS(CALL_2(take, L(1, 2, 3), fern_pack_number(-2)), 2, 3));
+  CHECK("1↓", IS(CALL_2(fern_DOWNWARDS_ARROW(), N32(1, 2, 70000), fern_DIGIT_ONE()), 2, 70000));
+  CHECK("«", IS(CALL_1(fern_LEFT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK(), N8(1, 2, 3)), 2, 3, 0));
+  CHECK("9»", IS(CALL_2(fern_RIGHT_POINTING_DOUBLE_ANGLE_QUOTATION_MARK(), L(1, 2, 3), fern_pack_number(9)), 9, 1, 2));
+  CHECK("8-bit list is stored as 8-bit", is_format(N8(1, 2), fern_Format_natural_8_bit));
+
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
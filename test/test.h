@@ -0,0 +1,89 @@
+// what the drivers in test/ share: CHECK counts and reports the failures, main returns whether there were any, and the
+// helpers build values as the VM does. include it after local.h, or after bqn.c for a driver of the VM itself
+
+static uint32_t failures;
+
+#define CHECK(NAME, COND) \
+  if(!(COND)) { \
+    printf("%s: %s\n", __FILE__, NAME); \
+    failures++; \
+  }
+
+// as op 27 of the VM applies a primitive modifier
+static inline fern_Box m2(fern_Box f, fern_Box m, fern_Box g) {
+  fern_Modifier2 modifier = fern_unpack_modifier2(m);
+  fern_Function result = fern_allocate_function();
+  result->type = fern_FunctionType_applied_c_m2;
+  result->applied_c_m2.f = f;
+  result->applied_c_m2.m = modifier->c;
+  result->applied_c_m2.g = g;
+  result->applied_c_m2.monad = modifier->monad;
+  result->applied_c_m2.dyad = modifier->dyad;
+  fern_internal_recognize_idiom(result);
+  fern_internal_compile_function(result);
+  return fern_pack_function(result);
+}
+
+// as op 26
+static inline fern_Box m1(fern_Box f, fern_Box m) {
+  fern_Modifier1 modifier = fern_unpack_modifier1(m);
+  fern_Function result = fern_allocate_function();
+  result->type = fern_FunctionType_applied_c_m1;
+  result->applied_c_m1.f = f;
+  result->applied_c_m1.m = modifier->c;
+  result->applied_c_m1.monad = modifier->monad;
+  result->applied_c_m1.dyad = modifier->dyad;
+  fern_internal_recognize_idiom(result);
+  return fern_pack_function(result);
+}
+
+// as op 20
+static inline fern_Box train3(fern_Box f, fern_Box g, fern_Box h) {
+  fern_Function result = fern_allocate_function();
+  result->type = fern_FunctionType_train3;
+  result->train3.f = f;
+  result->train3.g = g;
+  result->train3.h = h;
+  fern_internal_compile_function(result);
+  return fern_pack_function(result);
+}
+
+// a list of boxed numbers, as the VM builds it
+static inline fern_Box list(uint32_t n, const double * values) {
+  union fern_Data data;
+  fern_Box * cells = fern_init_data(&data, fern_Format_box, n);
+  for(uint32_t i = 0; i < n; i++) {
+    cells[i] = fern_pack_number(values[i]);
+  }
+  return fern_mk_array2(1, &n, &data, fern_DIGIT_ZERO());
+}
+
+static inline bool is(fern_Box x, double value) {
+  return fern_is_number(x) && x.number == value;
+}
+
+// an array of the shape with these numbers as its ravel, whatever their storage format
+static inline bool is_array(fern_Box x, uint32_t rank, const uint32_t * shape, const double * values) {
+  if(!fern_is_array(x)) {
+    return false;
+  }
+  fern_ArrayReader a = fern_read_array(fern_unpack_array(x));
+  if(fern_array_rank(a) != rank) {
+    return false;
+  }
+  for(uint32_t i = 0; i < rank; i++) {
+    if(fern_array_axis_length(a, i) != shape[i]) {
+      return false;
+    }
+  }
+  for(uint32_t i = 0; i < fern_array_num_cells(a); i++) {
+    if(!is(fern_array_get_cell(a, i), values[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static inline bool is_list(fern_Box x, uint32_t n, const double * values) {
+  return is_array(x, 1, &n, values);
+}
@@ -0,0 +1,133 @@
+// blocks run by the VM from a Program made by hand: tail calls through 𝕊 in constant stack, bodies rejected by a
+// predicate or a header, closures over the frame of a call, and frames coming back to the pool, also when a ⎊ catches a
+// throw out of nested calls, and modified assignment
+#include <stdio.h>
+
+#include "bqn.c"
+#include "test.h"
+
+enum { C0, CEQ, CMINUS, C1, C42, CN, CPLUS, C5, C100, CBANG, C10, C3, CA, CB, CUNDER };
+
+int main(void) {
+  fern_Box consts[] = {
+      fern_DIGIT_ZERO(), fern_EQUAL_SIGN(), fern_HYPHEN_MINUS(), fern_DIGIT_ONE(), fern_pack_number(42)
+    , fern_pack_number(1000000), fern_PLUS_SIGN(), fern_pack_number(5), fern_pack_number(100)
+    , fern_EXCLAMATION_MARK(), fern_pack_number(10), fern_pack_number(3), list(2, (double[]){ 10, 20 })
+    , list(2, (double[]){ 1, 2 })
+    , m2(fern_PLUS_SIGN(), fern_APL_FUNCTIONAL_SYMBOL_CIRCLE_JOT(), m2(fern_DIGIT_ZERO(), fern_MULTIMAP(), fern_SQUARE_IMAGE_OF_OR_EQUAL_TO()))
+  };
+  // the special variables of a function body are 𝕤 𝕩 𝕨, named ones follow
+  uint32_t bc[] = {
+    // body 0 @0, countdown: f ← {𝕩=0 ? 42 ; 𝕊 𝕩-1} ⋄ f N
+    33, 0, 0,  1, 1,  48,  6,  32, 0, 0,  0, CN,  16,  7,
+    // body 2 @14: 𝕩=0 ? 42
+    0, C0,  0, CEQ,  32, 0, 1,  17,  42,  0, C42,  7,
+    // body 3 @26: 𝕊 𝕩-1, a tail call
+    32, 0, 0,  32, 0, 1,  0, CMINUS,  0, C1,  17,  16,  7,
+    // body 4 @39, sum: 𝕩=0 ? 0
+    0, C0,  0, CEQ,  32, 0, 1,  17,  42,  0, C0,  7,
+    // body 5 @51: 𝕩 + 𝕊 𝕩-1, not a tail call
+    32, 0, 1,  0, CPLUS,  32, 0, 0,  32, 0, 1,  0, CMINUS,  0, C1,  17,  16,  17,  7,
+    // body 6 @70: g ← sum ⋄ g N
+    33, 0, 0,  1, 2,  48,  6,  32, 0, 0,  0, CN,  16,  7,
+    // body 7 @84, adder: a ← 𝕩 ⋄ {a + 𝕩}
+    33, 0, 3,  32, 0, 1,  48,  6,  1, 4,  7,
+    // body 8 @95: a + 𝕩, a from the frame of the adder
+    32, 1, 3,  0, CPLUS,  32, 0, 1,  17,  7,
+    // body 9 @105: (adder 5) 1
+    1, 3,  0, C5,  16,  0, C1,  16,  7,
+    // body 10 @114, header 𝕊 0: 100
+    0, C0,  43,  32, 0, 1,  47,  0, C100,  7,
+    // body 11 @124: 𝕩 + 1
+    32, 0, 1,  0, CPLUS,  0, C1,  17,  7,
+    // body 12 @133: header 0
+    1, 5,  0, C0,  16,  7,
+    // body 13 @139: header 5
+    1, 5,  0, C5,  16,  7,
+    // body 14 @145, deep: 𝕩=0 ? ! 0
+    0, C0,  0, CEQ,  32, 0, 1,  17,  42,  0, CBANG,  0, C0,  16,  7,
+    // body 15 @160: 1 + 𝕊 𝕩-1, not a tail call
+    0, C1,  0, CPLUS,  32, 0, 0,  32, 0, 1,  0, CMINUS,  0, C1,  17,  16,  17,  7,
+    // body 16 @178: deep
+    1, 6,  7,
+    // body 17 @181: f ← 10 ⋄ f -↩ 3 ⋄ f
+    33, 0, 0,  0, C10,  48,  6,  33, 0, 0,  0, CMINUS,  0, C3,  50,  6,  32, 0, 0,  7,
+    // body 18 @201: f ← 10‿20 ⋄ f +⌾(0⊸⊑)↩ 1‿2 ⋄ f
+    33, 0, 0,  0, CA,  48,  6,  33, 0, 0,  0, CUNDER,  0, CB,  50,  6,  32, 0, 0,  7,
+  };
+  uint32_t countdown[] = { 2, 3, (uint32_t)-1, (uint32_t)-1 };
+  uint32_t sum[] = { 4, 5, (uint32_t)-1, (uint32_t)-1 };
+  uint32_t adder[] = { 7 };
+  uint32_t add[] = { 8 };
+  uint32_t header[] = { 10, 11, (uint32_t)-1, (uint32_t)-1 };
+  uint32_t deep[] = { 14, 15, (uint32_t)-1, (uint32_t)-1 };
+  struct Block blocks[] = {
+      { 0, true, 1, (uint32_t[]){ 0 } }
+    , { 0, false, 4, countdown }
+    , { 0, false, 4, sum }
+    , { 0, false, 1, adder }
+    , { 0, false, 1, add }
+    , { 0, false, 4, header }
+    , { 0, false, 4, deep }
+  };
+  struct Body bodies[] = {
+      { 0, 1, 0, NULL }, { 0 }, { 14, 3, 0, NULL }, { 26, 3, 0, NULL }, { 39, 3, 0, NULL }, { 51, 3, 0, NULL }
+    , { 70, 1, 0, NULL }, { 84, 4, 0, NULL }, { 95, 3, 0, NULL }, { 105, 1, 0, NULL }, { 114, 3, 0, NULL }
+    , { 124, 3, 0, NULL }, { 133, 1, 0, NULL }, { 139, 1, 0, NULL }
+    , { 145, 3, 0, NULL }, { 160, 3, 0, NULL }, { 178, 1, 0, NULL }
+    , { 181, 1, 0, NULL }, { 201, 1, 0, NULL }
+  };
+  struct Program program = {
+      .bc = bc, .num_bc = sizeof(bc) / sizeof(*bc), .num_consts = sizeof(consts) / sizeof(*consts), .consts = consts
+    , .num_blocks = sizeof(blocks) / sizeof(*blocks), .blocks = blocks, .num_bodies = sizeof(bodies) / sizeof(*bodies)
+    , .bodies = bodies
+  };
+  Program_prepare(&program);
+  CHECK("max stack of the countdown", bodies[0].max_stack == 2 && bodies[3].max_stack == 4);
+
+  struct Env * env = Env_allocate(1);
+  env->type = ObjectType_env;
+  env->parent = NULL;
+  env->program = &program;
+  env->num_vars = 1;
+  env->first_named_var = 1;
+  Var_init(env->vars, &program, 0);
+
+  // a million calls deep, more than the value stack holds unless each tail call reuses the frame before it
+  CHECK("countdown", is(run_bc(bc, 0, env), 42));
+  CHECK("countdown again", is(run_bc(bc, 0, env), 42));
+  consts[CN] = fern_pack_number(1000);
+  CHECK("sum", is(run_bc(bc, 70, env), 500500));
+  CHECK("closure", is(run_bc(bc, 105, env), 6));
+  CHECK("header matches", is(run_bc(bc, 133, env), 100));
+  CHECK("header rejects", is(run_bc(bc, 139, env), 6));
+
+  // the frames of the thousand nested calls of sum are all back in their class
+  uint32_t pooled = 0;
+  for(struct Env * pool = env_pool[Env_class(3)]; pool != NULL; pool = pool->parent) {
+    pooled++;
+  }
+  CHECK("frames back in the pool", pooled >= 1000);
+  CHECK("value stack given back", vm_stack_top == 0);
+
+  // ! at the bottom of ten calls jumps over their returns, ⎊ gives back their slices and frames. without that the value
+  // stack runs over long before the last of these
+  fern_Box caught = m2(run_bc(bc, 178, env), fern_CIRCLED_TRIANGLE_DOWN(), fern_pack_number(-1));
+  bool all_caught = true;
+  for(uint32_t i = 0; i < 100000; i++) {
+    all_caught &= is(CALL_1(caught, fern_pack_number(10)), -1);
+  }
+  CHECK("throw caught", all_caught);
+  CHECK("value stack given back after the throws", vm_stack_top == 0 && vm_frames_top == 0);
+  pooled = 0;
+  for(struct Env * pool = env_pool[Env_class(3)]; pool != NULL; pool = pool->parent) {
+    pooled++;
+  }
+  CHECK("frames back in the pool after the throws", pooled >= 1000 && pooled < 1100);
+
+  // a F↩ b is a ↩ a F b, so ⌾ builds on b with 0⊑a on the left
+  CHECK("f -↩ 3", is(run_bc(bc, 181, env), 7));
+  CHECK("f +⌾(0⊸⊑)↩ 1‿2", is_list(run_bc(bc, 201, env), 2, (double[]){ 11, 2 }));
+
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}